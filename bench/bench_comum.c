@@ -0,0 +1,86 @@
+#include "bench_comum.h"
+#include <stdlib.h>
+#include "pico/stdlib.h"
+
+#if COLETOR_HOST
+#include <time.h>
+
+uint64_t bench_agora_ns(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (uint64_t)t.tv_sec * 1000000000u + (uint64_t)t.tv_nsec;
+}
+#else
+// Amostras longas o bastante para a resolução de 1 us não pesar
+uint64_t bench_agora_ns(void) {
+    return time_us_64() * 1000;
+}
+#endif
+
+// Referência: só ALU, sem memória nem código do repositório, então só muda com a máquina
+static volatile uint32_t semente_referencia = 1;
+
+static void executar_referencia(uint32_t i) {
+    uint32_t x = semente_referencia + i;
+    for (int p = 0; p < PASSOS_REFERENCIA; p++) {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+    }
+    semente_referencia = x;
+}
+
+static const kernel_t kernel_referencia = { "referencia", executar_referencia };
+
+static int comparar_double(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+static uint64_t rodar(const kernel_t *k, uint32_t primeira, uint32_t iteracoes) {
+    uint64_t inicio = bench_agora_ns();
+    for (uint32_t i = 0; i < iteracoes; i++) k->executar(primeira + i);
+    return bench_agora_ns() - inicio;
+}
+
+static uint32_t calibrar(const kernel_t *k) {
+    uint32_t n = 1;
+    while (rodar(k, 0, n) < ALVO_AMOSTRA_NS && n < MAX_ITERACOES) n *= 2;
+    return n;
+}
+
+// Cada amostra do kernel é seguida de uma da referência, para as duas verem a mesma máquina
+void bench_medir(const kernel_t *k, resultado_t *r) {
+    static uint32_t n_referencia;
+    if (n_referencia == 0) n_referencia = calibrar(&kernel_referencia);
+    uint32_t n = calibrar(k);
+
+    double amostras[AMOSTRAS];
+    double soma = 0;
+    r->referencia = 0;
+    for (int s = 0; s < AMOSTRAS; s++) {
+        amostras[s] = (double)rodar(k, (uint32_t)s * n, n) / n;
+        soma += amostras[s];
+        double referencia = (double)rodar(&kernel_referencia, (uint32_t)s * n_referencia, n_referencia) / n_referencia;
+        if (s == 0 || referencia < r->referencia) r->referencia = referencia;
+    }
+    qsort(amostras, AMOSTRAS, sizeof(amostras[0]), comparar_double);
+    r->iteracoes = n;
+    r->mediana = amostras[AMOSTRAS / 2];
+    r->minimo = amostras[0];
+    r->maximo = amostras[AMOSTRAS - 1];
+    r->media = soma / AMOSTRAS;
+}
+
+// Um kernel por linha, cada linha com o prefixo dado (o serial do dispositivo usa "#B ")
+void bench_escrever_json(FILE *f, const char *prefixo, const kernel_t *kernels, const resultado_t *resultados, size_t n) {
+    fprintf(f, "%s{\"plataforma\": \"%s\", \"unidade\": \"ns/op\", \"amostras\": %d, \"kernels\": [\n",
+            prefixo, PLATAFORMA, AMOSTRAS);
+    for (size_t i = 0; i < n; i++) {
+        const resultado_t *r = &resultados[i];
+        fprintf(f, "%s  {\"nome\": \"%s\", \"mediana\": %.1f, \"min\": %.1f, \"media\": %.1f, \"max\": %.1f, \"ref\": %.1f, \"iteracoes\": %lu}%s\n",
+                prefixo, kernels[i].nome, r->mediana, r->minimo, r->media, r->maximo, r->referencia,
+                (unsigned long)r->iteracoes, i + 1 < n ? "," : "");
+    }
+    fprintf(f, "%s]}\n", prefixo);
+}
@@ -0,0 +1,39 @@
+// Medição comum aos microbenchmarks: mediana de amostras e relatório JSON em ns por operação,
+// no formato que tools/comparar_bench.py compara com bench/base_*.json. Cada kernel leva também
+// o tempo de um laço de referência fixo, medido entre as suas amostras, que o comparador usa
+// para descontar a velocidade da máquina e o clock do momento.
+#ifndef BENCH_COMUM_H
+#define BENCH_COMUM_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#define AMOSTRAS          21         // Mediana de amostras ímpares
+#define ALVO_AMOSTRA_NS   2000000    // Iterações por amostra dobram até a amostra durar ~2 ms
+#define MAX_ITERACOES     (1u << 22)
+#define PASSOS_REFERENCIA 64         // Rodadas de xorshift dependentes por operação de referência
+
+#if COLETOR_HOST
+#define PLATAFORMA "host"
+#else
+#define PLATAFORMA "rp2040"
+#define INTERVALO_RELATORIO_MS 5000
+#endif
+
+typedef struct {
+    const char *nome;
+    void (*executar)(uint32_t i);
+} kernel_t;
+
+typedef struct {
+    uint32_t iteracoes;
+    double mediana, minimo, media, maximo;   // ns por operação
+    double referencia;                       // Mínimo da referência intercalada, ns por operação
+} resultado_t;
+
+uint64_t bench_agora_ns(void);
+void bench_medir(const kernel_t *k, resultado_t *r);
+void bench_escrever_json(FILE *f, const char *prefixo, const kernel_t *kernels, const resultado_t *resultados, size_t n);
+
+#endif // BENCH_COMUM_H
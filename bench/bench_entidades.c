@@ -0,0 +1,179 @@
+// Custo de um quadro de colisões conforme o número de entidades cresce de 1 a 512: mover todas,
+// remontar a grade e achar todos os pares sobrepostos, contra o teste de todos os pares
+// (o verificar_colisao par a par de antes). Mesmo JSON e mesma comparação de bench_ssd1306.
+//
+//   bench_entidades [-o resultado.json]    (host; também imprime a tabela por quantidade)
+//   No dispositivo o JSON sai pelo serial em linhas "#B ", repetido a cada poucos segundos.
+#include <stdio.h>
+#include <string.h>
+#include "pico/stdlib.h"
+#include "entidades.h"
+#include "bench_comum.h"
+
+#define LARGURA_CAMPO 128
+#define ALTURA_CAMPO  64
+#define NUM_QUANTIDADES 10        // 1, 2, 4, ..., 512
+
+#if ENTIDADES_CAPACIDADE < (1 << (NUM_QUANTIDADES - 1))
+#error "bench_entidades precisa de ENTIDADES_CAPACIDADE=512 (CMakeLists.txt define)"
+#endif
+
+static entidades_t entidades;
+static grade_t grade;
+static uint32_t quantidade_preparada;
+static volatile uint32_t pares_vistos;   // Impede o compilador de descartar o trabalho
+
+// Jogador no centro e o resto espalhado: três coletáveis para cada perigo, todos andando
+static void preparar(uint32_t quantidade) {
+    if (quantidade == quantidade_preparada) return;
+    quantidade_preparada = quantidade;
+    entidades_iniciar(&entidades);
+    entidades_criar(&entidades, ENTIDADE_JOGADOR, 60, 28, 8, 8);
+    uint32_t estado = 0x12345678u;
+    for (uint32_t i = 1; i < quantidade; i++) {
+        estado = estado * 1664525u + 1013904223u;
+        bool perigo = (i % 4) == 0;
+        int tamanho = perigo ? 6 : 4;
+        entidade_id_t id = entidades_criar(&entidades, perigo ? ENTIDADE_PERIGO : ENTIDADE_COLETAVEL,
+                                           (int)((estado >> 8) % (LARGURA_CAMPO - tamanho)),
+                                           (int)((estado >> 20) % (ALTURA_CAMPO - tamanho)), tamanho, tamanho);
+        uint16_t k = entidades_indice(&entidades, id);
+        entidades.vx[k] = (int8_t)((estado >> 4) % 5) - 2;
+        entidades.vy[k] = (int8_t)((estado >> 12) % 5) - 2;
+    }
+}
+
+// Quica nas bordas do campo
+static void mover(void) {
+    entidades_mover(&entidades);
+    for (uint16_t i = 0; i < entidades.quantidade; i++) {
+        if (entidades.x[i] < 0 || entidades.x[i] + entidades.largura[i] > LARGURA_CAMPO) {
+            entidades.vx[i] = (int8_t)-entidades.vx[i];
+            entidades.x[i] += 2 * entidades.vx[i];
+        }
+        if (entidades.y[i] < 0 || entidades.y[i] + entidades.altura[i] > ALTURA_CAMPO) {
+            entidades.vy[i] = (int8_t)-entidades.vy[i];
+            entidades.y[i] += 2 * entidades.vy[i];
+        }
+    }
+}
+
+static uint32_t pares_grade(void) {
+    grade_montar(&grade, &entidades);
+    return grade_pares(&grade, &entidades, NULL, NULL);
+}
+
+static uint32_t pares_ingenuo(void) {
+    uint32_t pares = 0;
+    for (uint16_t a = 0; a < entidades.quantidade; a++) {
+        for (uint16_t b = a + 1; b < entidades.quantidade; b++) {
+            pares += entidades.x[a] < entidades.x[b] + entidades.largura[b] &&
+                     entidades.x[a] + entidades.largura[a] > entidades.x[b] &&
+                     entidades.y[a] < entidades.y[b] + entidades.altura[b] &&
+                     entidades.y[a] + entidades.altura[a] > entidades.y[b];
+        }
+    }
+    return pares;
+}
+
+#define KERNELS_QUANTIDADE(n) \
+    static void grade_##n(uint32_t i) { (void)i; preparar(n); mover(); pares_vistos += pares_grade(); } \
+    static void ingenuo_##n(uint32_t i) { (void)i; preparar(n); mover(); pares_vistos += pares_ingenuo(); }
+KERNELS_QUANTIDADE(1)
+KERNELS_QUANTIDADE(2)
+KERNELS_QUANTIDADE(4)
+KERNELS_QUANTIDADE(8)
+KERNELS_QUANTIDADE(16)
+KERNELS_QUANTIDADE(32)
+KERNELS_QUANTIDADE(64)
+KERNELS_QUANTIDADE(128)
+KERNELS_QUANTIDADE(256)
+KERNELS_QUANTIDADE(512)
+
+// Pares: grade e teste de todos os pares da mesma quantidade lado a lado
+static const kernel_t kernels[] = {
+    { "grade_1", grade_1 },     { "ingenuo_1", ingenuo_1 },
+    { "grade_2", grade_2 },     { "ingenuo_2", ingenuo_2 },
+    { "grade_4", grade_4 },     { "ingenuo_4", ingenuo_4 },
+    { "grade_8", grade_8 },     { "ingenuo_8", ingenuo_8 },
+    { "grade_16", grade_16 },   { "ingenuo_16", ingenuo_16 },
+    { "grade_32", grade_32 },   { "ingenuo_32", ingenuo_32 },
+    { "grade_64", grade_64 },   { "ingenuo_64", ingenuo_64 },
+    { "grade_128", grade_128 }, { "ingenuo_128", ingenuo_128 },
+    { "grade_256", grade_256 }, { "ingenuo_256", ingenuo_256 },
+    { "grade_512", grade_512 }, { "ingenuo_512", ingenuo_512 },
+};
+#define NUM_KERNELS (sizeof(kernels) / sizeof(kernels[0]))
+// Com 1 e 2 entidades o tempo é quase só o da chamada, e o ruído passa de qualquer regressão:
+// aparecem na tabela, mas não no JSON que tools/comparar_bench.py compara
+#define PRIMEIRO_NO_JSON 4
+
+static resultado_t resultados[NUM_KERNELS];
+
+// A grade tem que achar exatamente os mesmos pares que o teste de todos contra todos
+static bool conferir(void) {
+    for (uint32_t q = 0; q < NUM_QUANTIDADES; q++) {
+        preparar(1u << q);
+        for (int quadro = 0; quadro < 100; quadro++) {
+            mover();
+            uint32_t grade = pares_grade(), ingenuo = pares_ingenuo();
+            if (grade != ingenuo) {
+                printf("ERRO: %lu entidades, quadro %d: grade achou %lu pares, teste completo %lu\n",
+                       (unsigned long)(1u << q), quadro, (unsigned long)grade, (unsigned long)ingenuo);
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static void imprimir_tabela(FILE *f) {
+    fprintf(f, "%-10s %14s %14s %8s\n", "entidades", "grade ns", "ingenuo ns", "razão");
+    for (uint32_t q = 0; q < NUM_QUANTIDADES; q++) {
+        const resultado_t *grade = &resultados[2 * q], *ingenuo = &resultados[2 * q + 1];
+        fprintf(f, "%-10lu %14.1f %14.1f %8.2f\n", (unsigned long)(1u << q), grade->mediana, ingenuo->mediana,
+                ingenuo->mediana / grade->mediana);
+    }
+}
+
+int main(int argc, char **argv) {
+#if COLETOR_HOST
+    const char *caminho = NULL;
+    if (argc == 3 && !strcmp(argv[1], "-o")) caminho = argv[2];
+    else if (argc != 1) {
+        fprintf(stderr, "uso: %s [-o resultado.json]\n", argv[0]);
+        return 2;
+    }
+    if (!conferir()) return 1;
+#else
+    stdio_init_all();
+    sleep_ms(2000);  // Tempo para o monitor serial conectar
+    if (!conferir()) while (true) sleep_ms(1000);
+#endif
+    for (size_t i = 0; i < NUM_KERNELS; i++) bench_medir(&kernels[i], &resultados[i]);
+
+#if COLETOR_HOST
+    imprimir_tabela(stdout);
+    if (caminho) {
+        FILE *f = fopen(caminho, "w");
+        if (!f) {
+            perror(caminho);
+            return 2;
+        }
+        bench_escrever_json(f, "", kernels + PRIMEIRO_NO_JSON, resultados + PRIMEIRO_NO_JSON,
+                            NUM_KERNELS - PRIMEIRO_NO_JSON);
+        fclose(f);
+    } else {
+        bench_escrever_json(stdout, "", kernels + PRIMEIRO_NO_JSON, resultados + PRIMEIRO_NO_JSON,
+                            NUM_KERNELS - PRIMEIRO_NO_JSON);
+    }
+    return 0;
+#else
+    while (true) {
+        imprimir_tabela(stdout);
+        bench_escrever_json(stdout, "#B ", kernels + PRIMEIRO_NO_JSON, resultados + PRIMEIRO_NO_JSON,
+                            NUM_KERNELS - PRIMEIRO_NO_JSON);
+        sleep_ms(INTERVALO_RELATORIO_MS);
+    }
+#endif
+}
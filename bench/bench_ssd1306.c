@@ -0,0 +1,195 @@
+// Microbenchmarks do driver SSD1306: cada primitiva de desenho e um quadro completo de jogo.
+// No host roda contra a HAL simulada e mede com CLOCK_MONOTONIC; no RP2040 mede com time_us_64
+// (ver bench_comum.c). O resultado é JSON em ns por operação, comparado com bench/base_*.json
+// por tools/comparar_bench.py.
+//
+//   bench_ssd1306 [-o resultado.json]      (host)
+//   No dispositivo o mesmo JSON sai pelo serial em linhas "#B ", repetido a cada poucos segundos.
+#include <stdio.h>
+#include <string.h>
+#include "pico/stdlib.h"
+#include "hardware/i2c.h"
+#include "ssd1306.h"
+#include "framebuffer.h"
+#include "sprite.h"
+#include "compositor.h"
+#include "bench_comum.h"
+
+#define NUM_COORDENADAS   256
+
+#define LARGURA_TELA      128
+#define ALTURA_TELA       64
+#define ENDERECO_OLED     0x3C
+#define I2C_PORT          i2c1
+#define I2C_SDA_PIN       14
+#define I2C_SCL_PIN       15
+#define I2C_FREQUENCIA    400000
+
+#if COLETOR_HOST
+#include "sim.h"
+#endif
+
+static ssd1306_t tela;
+static compositor_t compositor;        // Borda, HUD e sprites sobre a tela, como em main.c
+static uint8_t coordenadas[NUM_COORDENADAS][2];
+
+// ─── Kernels: o índice da iteração varia posição e cor para o driver não pular trabalho ───
+static void bench_fill(uint32_t i) {
+    ssd1306_fill(&tela, i & 1);
+}
+
+static void bench_pixel(uint32_t i) {
+    const uint8_t *c = coordenadas[i % NUM_COORDENADAS];
+    ssd1306_pixel(&tela, c[0], c[1], (i / NUM_COORDENADAS) & 1);
+}
+
+// Mesmas operações pela geometria fixa de framebuffer.hpp
+static void bench_pixel_128x64(uint32_t i) {
+    const uint8_t *c = coordenadas[i % NUM_COORDENADAS];
+    framebuffer_128x64_pixel(&tela, c[0], c[1], (i / NUM_COORDENADAS) & 1);
+}
+
+static void bench_rect_contorno(uint32_t i) {
+    ssd1306_rect(&tela, 3 + (i & 7), 10 + (i & 15), 60, 30, i & 1, false);
+}
+
+static void bench_rect_cheio(uint32_t i) {
+    ssd1306_rect(&tela, 3 + (i & 7), 10 + (i & 15), 60, 30, i & 1, true);
+}
+
+static void bench_rect_cheio_128x64(uint32_t i) {
+    framebuffer_128x64_fill_rect(&tela, 10 + (i & 15), 3 + (i & 7), 60, 30, i & 1);
+}
+
+// Contorno 8x8 com máscara, fora do alinhamento de página e às vezes cortado na borda direita
+static const uint8_t sprite_pixels[] = { 0xFF, 0x81, 0x81, 0x81, 0x81, 0x81, 0x81, 0xFF };
+static const sprite_t sprite = { 8, 8, 1, sprite_pixels, sprite_pixels };
+
+static void bench_sprite(uint32_t i) {
+    sprite_draw(&tela, &sprite, 0, 10 + (int)(i & 127), 3 + (int)(i & 7) * 7);
+}
+
+static void bench_line(uint32_t i) {
+    ssd1306_line(&tela, i & 31, 0, LARGURA_TELA - 1 - (i & 31), ALTURA_TELA - 1, i & 1);
+}
+
+static void bench_string_alinhada(uint32_t i) {
+    ssd1306_draw_string(&tela, (i & 1) ? "Pontos: 123" : "Pontos: 456", 2, 8, false);
+}
+
+static void bench_string_desalinhada(uint32_t i) {
+    ssd1306_draw_string(&tela, (i & 1) ? "Pontos: 123" : "Pontos: 456", 2, 13, false);
+}
+
+// Mesmo desenho de desenhar_quadro em main.c, com o jogador andando, mais o envio síncrono
+static void bench_quadro_jogo(uint32_t i) {
+    char texto[20];
+    int x = 4 + (int)(i % 100), y = 14 + (int)(i % 40);
+    ssd1306_fill(&tela, false);
+    ssd1306_fill_rect(&tela, 0, 0, LARGURA_TELA, 1, true);
+    ssd1306_fill_rect(&tela, 0, ALTURA_TELA - 1, LARGURA_TELA, 1, true);
+    ssd1306_fill_rect(&tela, 0, 0, 1, ALTURA_TELA, true);
+    ssd1306_fill_rect(&tela, LARGURA_TELA - 1, 0, 1, ALTURA_TELA, true);
+    ssd1306_fill_rect(&tela, x, y, 8, 8, true);
+    ssd1306_fill_rect(&tela, 100, 40, 4, 4, true);
+    sprintf(texto, "Pontos: %lu", (unsigned long)(i % 1000));
+    ssd1306_draw_string(&tela, texto, 2, 2, false);
+    ssd1306_send_data(&tela);
+}
+
+// O mesmo quadro pelas camadas: a borda já está na camada 0 e a pontuação muda a cada 64 quadros
+static void bench_quadro_camadas(uint32_t i) {
+    char texto[20];
+    int x = 4 + (int)(i % 100), y = 14 + (int)(i % 40);
+    if ((i & 63) == 0) {
+        sprintf(texto, "Pontos: %lu", (unsigned long)(i / 64 % 1000));
+        compositor_erase(&compositor, 1);
+        ssd1306_draw_string(compositor_layer(&compositor, 1), texto, 2, 2, false);
+    }
+    compositor_erase(&compositor, 2);
+    framebuffer_128x64_fill_rect(compositor_layer(&compositor, 2), x, y, 8, 8, true);
+    framebuffer_128x64_fill_rect(compositor_layer(&compositor, 2), 100, 40, 4, 4, true);
+    compositor_compose(&compositor);
+    ssd1306_send_data(&tela);
+}
+
+// Inicialização inteira do painel; por último, porque invalida a imagem que o painel tem
+static void bench_config(uint32_t i) {
+    (void)i;
+    ssd1306_config(&tela);
+}
+
+static const kernel_t kernels[] = {
+    { "fill", bench_fill },
+    { "pixel", bench_pixel },
+    { "pixel_128x64", bench_pixel_128x64 },
+    { "rect_contorno", bench_rect_contorno },
+    { "rect_cheio", bench_rect_cheio },
+    { "rect_cheio_128x64", bench_rect_cheio_128x64 },
+    { "sprite", bench_sprite },
+    { "line", bench_line },
+    { "draw_string_alinhada", bench_string_alinhada },
+    { "draw_string_desalinhada", bench_string_desalinhada },
+    { "quadro_jogo", bench_quadro_jogo },
+    { "quadro_camadas", bench_quadro_camadas },
+    { "config", bench_config },
+};
+#define NUM_KERNELS (sizeof(kernels) / sizeof(kernels[0]))
+
+static resultado_t resultados[NUM_KERNELS];
+
+static void preparar(void) {
+    uint32_t estado = 0x12345678u;
+    for (int i = 0; i < NUM_COORDENADAS; i++) {
+        estado = estado * 1664525u + 1013904223u;
+        coordenadas[i][0] = (uint8_t)((estado >> 8) % LARGURA_TELA);
+        coordenadas[i][1] = (uint8_t)((estado >> 20) % ALTURA_TELA);
+    }
+
+    i2c_init(I2C_PORT, I2C_FREQUENCIA);
+    gpio_set_function(I2C_SDA_PIN, GPIO_FUNC_I2C);
+    gpio_set_function(I2C_SCL_PIN, GPIO_FUNC_I2C);
+    gpio_pull_up(I2C_SDA_PIN);
+    gpio_pull_up(I2C_SCL_PIN);
+    ssd1306_init(&tela, LARGURA_TELA, ALTURA_TELA, false, ENDERECO_OLED, I2C_PORT);
+    ssd1306_config(&tela);
+    compositor_init(&compositor, &tela, 3);
+    ssd1306_t *borda = compositor_layer(&compositor, 0);
+    framebuffer_128x64_fill_rect(borda, 0, 0, LARGURA_TELA, 1, true);
+    framebuffer_128x64_fill_rect(borda, 0, ALTURA_TELA - 1, LARGURA_TELA, 1, true);
+    framebuffer_128x64_fill_rect(borda, 0, 0, 1, ALTURA_TELA, true);
+    framebuffer_128x64_fill_rect(borda, LARGURA_TELA - 1, 0, 1, ALTURA_TELA, true);
+}
+
+int main(int argc, char **argv) {
+#if COLETOR_HOST
+    const char *caminho = NULL;
+    if (argc == 3 && !strcmp(argv[1], "-o")) caminho = argv[2];
+    else if (argc != 1) {
+        fprintf(stderr, "uso: %s [-o resultado.json]\n", argv[0]);
+        return 2;
+    }
+    sim_reiniciar();
+#else
+    stdio_init_all();
+    sleep_ms(2000);  // Tempo para o monitor serial conectar
+#endif
+    preparar();
+    for (size_t i = 0; i < NUM_KERNELS; i++) bench_medir(&kernels[i], &resultados[i]);
+
+#if COLETOR_HOST
+    FILE *f = caminho ? fopen(caminho, "w") : stdout;
+    if (!f) {
+        perror(caminho);
+        return 2;
+    }
+    bench_escrever_json(f, "", kernels, resultados, NUM_KERNELS);
+    if (f != stdout) fclose(f);
+    return 0;
+#else
+    while (true) {
+        bench_escrever_json(stdout, "#B ", kernels, resultados, NUM_KERNELS);
+        sleep_ms(INTERVALO_RELATORIO_MS);
+    }
+#endif
+}
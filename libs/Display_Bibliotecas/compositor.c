@@ -0,0 +1,94 @@
+#include "compositor.h"
+#include <stdlib.h>
+#include <string.h>
+
+static void widen(uint8_t *min, uint8_t *max, uint8_t x0, uint8_t x1) {
+    if (x0 < *min) *min = x0;
+    if (x1 > *max) *max = x1;
+}
+
+bool compositor_init(compositor_t *compositor, ssd1306_t *output, uint8_t count) {
+    if (count > COMPOSITOR_MAX_LAYERS || (output->width & 3) || output->ram_buffer == NULL) return false;
+    memset(compositor, 0, sizeof(*compositor));
+    compositor->output = output;
+    compositor->count = count;
+    for (uint8_t i = 0; i < count; ++i) {
+        ssd1306_t *layer = &compositor->layers[i];
+        layer->width = output->width;
+        layer->height = output->height;
+        layer->pages = output->pages;
+        layer->bufsize = output->bufsize;
+        // Same alignment as ssd1306_init: pixels on a word boundary after the control byte
+        uint8_t *raw = calloc(layer->bufsize + 3, sizeof(uint8_t));
+        if (raw == NULL) {
+            while (i--) free(compositor->layers[i].ram_buffer - 3);
+            memset(compositor, 0, sizeof(*compositor));
+            return false;
+        }
+        layer->ram_buffer = raw + 3;
+        memset(layer->dirty_min, 0xFF, sizeof(layer->dirty_min));
+        memset(compositor->drawn_min[i], 0xFF, sizeof(compositor->drawn_min[i]));
+    }
+    compositor_invalidate(compositor);
+    return true;
+}
+
+ssd1306_t *compositor_layer(compositor_t *compositor, uint8_t index) {
+    return &compositor->layers[index];
+}
+
+void compositor_erase(compositor_t *compositor, uint8_t index) {
+    ssd1306_t *layer = &compositor->layers[index];
+    uint8_t *drawn_min = compositor->drawn_min[index], *drawn_max = compositor->drawn_max[index];
+    for (uint8_t page = 0; page < layer->pages; ++page) {
+        // Not composed yet counts as drawn too
+        widen(&drawn_min[page], &drawn_max[page], layer->dirty_min[page], layer->dirty_max[page]);
+        layer->dirty_min[page] = 0xFF;
+        layer->dirty_max[page] = 0;
+        if (drawn_min[page] > drawn_max[page]) continue;
+        memset(&layer->ram_buffer[1 + page * layer->width + drawn_min[page]], 0, drawn_max[page] - drawn_min[page] + 1);
+        widen(&compositor->damage_min[page], &compositor->damage_max[page], drawn_min[page], drawn_max[page]);
+        drawn_min[page] = 0xFF;
+        drawn_max[page] = 0;
+    }
+}
+
+void compositor_invalidate(compositor_t *compositor) {
+    memset(compositor->damage_min, 0, sizeof(compositor->damage_min));
+    memset(compositor->damage_max, compositor->output->width - 1, sizeof(compositor->damage_max));
+}
+
+uint16_t compositor_compose(compositor_t *compositor) {
+    ssd1306_t *output = compositor->output;
+    uint16_t words = 0;
+    for (uint8_t page = 0; page < output->pages; ++page) {
+        uint8_t x0 = compositor->damage_min[page], x1 = compositor->damage_max[page];
+        for (uint8_t i = 0; i < compositor->count; ++i) {
+            ssd1306_t *layer = &compositor->layers[i];
+            widen(&x0, &x1, layer->dirty_min[page], layer->dirty_max[page]);
+            widen(&compositor->drawn_min[i][page], &compositor->drawn_max[i][page],
+                  layer->dirty_min[page], layer->dirty_max[page]);
+            layer->dirty_min[page] = 0xFF;
+            layer->dirty_max[page] = 0;
+        }
+        compositor->damage_min[page] = 0xFF;
+        compositor->damage_max[page] = 0;
+        if (x0 > x1) continue;
+
+        unsigned first = x0 >> 2, last = x1 >> 2;
+        unsigned base = page * output->width / 4;
+        uint32_t *out = (uint32_t *)&output->ram_buffer[1] + base;
+        const uint32_t *sources[COMPOSITOR_MAX_LAYERS];
+        for (uint8_t i = 0; i < compositor->count; ++i) {
+            sources[i] = (const uint32_t *)&compositor->layers[i].ram_buffer[1] + base;
+        }
+        for (unsigned w = first; w <= last; ++w) {
+            uint32_t value = 0;
+            for (uint8_t i = 0; i < compositor->count; ++i) value |= sources[i][w];
+            out[w] = value;
+        }
+        ssd1306_mark_dirty(output, page, (uint8_t)(first * 4), (uint8_t)(last * 4 + 3));
+        words += (uint16_t)(last - first + 1);
+    }
+    return words;
+}
@@ -0,0 +1,42 @@
+#ifndef COMPOSITOR_H
+#define COMPOSITOR_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "ssd1306.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define COMPOSITOR_MAX_LAYERS 4
+
+// Builds an output back buffer as the OR of a stack of layers. Each layer is an ssd1306_t with
+// no panel behind it, so every drawing call works on it, and its dirty ranges tell the
+// compositor what changed. compositor_compose only redoes those columns, a word at a time.
+typedef struct {
+    ssd1306_t *output;
+    ssd1306_t layers[COMPOSITOR_MAX_LAYERS];
+    uint8_t count;
+    uint8_t drawn_min[COMPOSITOR_MAX_LAYERS][SSD1306_MAX_PAGES];  // Drawn since the last erase
+    uint8_t drawn_max[COMPOSITOR_MAX_LAYERS][SSD1306_MAX_PAGES];
+    uint8_t damage_min[SSD1306_MAX_PAGES];   // Output columns to redo besides the layers' own
+    uint8_t damage_max[SSD1306_MAX_PAGES];
+} compositor_t;
+
+// Layers get the output geometry, whose width must be a multiple of 4. False without memory,
+// with nothing left allocated.
+bool compositor_init(compositor_t *compositor, ssd1306_t *output, uint8_t count);
+ssd1306_t *compositor_layer(compositor_t *compositor, uint8_t index);
+// Clears everything the layer drew since its last erase, e.g. last frame's sprites
+void compositor_erase(compositor_t *compositor, uint8_t index);
+// Something else drew into the output: the next compose redoes all of it
+void compositor_invalidate(compositor_t *compositor);
+// Returns the number of 32-bit words written to the output
+uint16_t compositor_compose(compositor_t *compositor);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // COMPOSITOR_H
@@ -0,0 +1,38 @@
+#include "framebuffer.h"
+#include "framebuffer.hpp"
+
+void framebuffer_128x64_pixel(ssd1306_t *ssd, int x, int y, bool value) {
+    Framebuffer128x64(*ssd).pixel(x, y, value);
+}
+
+void framebuffer_128x64_fill(ssd1306_t *ssd, bool value) {
+    Framebuffer128x64(*ssd).fill(value);
+}
+
+void framebuffer_128x64_fill_rect(ssd1306_t *ssd, int x, int y, int width, int height, bool value) {
+    Framebuffer128x64(*ssd).fill_rect(x, y, width, height, value);
+}
+
+void framebuffer_128x32_pixel(ssd1306_t *ssd, int x, int y, bool value) {
+    Framebuffer128x32(*ssd).pixel(x, y, value);
+}
+
+void framebuffer_128x32_fill(ssd1306_t *ssd, bool value) {
+    Framebuffer128x32(*ssd).fill(value);
+}
+
+void framebuffer_128x32_fill_rect(ssd1306_t *ssd, int x, int y, int width, int height, bool value) {
+    Framebuffer128x32(*ssd).fill_rect(x, y, width, height, value);
+}
+
+void framebuffer_sh1106_pixel(ssd1306_t *ssd, int x, int y, bool value) {
+    FramebufferSh1106(*ssd).pixel(x, y, value);
+}
+
+void framebuffer_sh1106_fill(ssd1306_t *ssd, bool value) {
+    FramebufferSh1106(*ssd).fill(value);
+}
+
+void framebuffer_sh1106_fill_rect(ssd1306_t *ssd, int x, int y, int width, int height, bool value) {
+    FramebufferSh1106(*ssd).fill_rect(x, y, width, height, value);
+}
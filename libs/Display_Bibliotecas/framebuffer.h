@@ -0,0 +1,31 @@
+#ifndef FRAMEBUFFER_H
+#define FRAMEBUFFER_H
+
+#include <stdbool.h>
+#include "ssd1306.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// C entry points to framebuffer.hpp, one set per panel geometry. Same behaviour as
+// ssd1306_pixel/fill/fill_rect, for an ssd1306_t initialised with that geometry
+// (the SH1106 one with width 132). The SH1106 set only draws off-screen: ssd1306_send_data
+// addresses windows with 0x21/0x22, which the SH1106 does not have.
+void framebuffer_128x64_pixel(ssd1306_t *ssd, int x, int y, bool value);
+void framebuffer_128x64_fill(ssd1306_t *ssd, bool value);
+void framebuffer_128x64_fill_rect(ssd1306_t *ssd, int x, int y, int width, int height, bool value);
+
+void framebuffer_128x32_pixel(ssd1306_t *ssd, int x, int y, bool value);
+void framebuffer_128x32_fill(ssd1306_t *ssd, bool value);
+void framebuffer_128x32_fill_rect(ssd1306_t *ssd, int x, int y, int width, int height, bool value);
+
+void framebuffer_sh1106_pixel(ssd1306_t *ssd, int x, int y, bool value);
+void framebuffer_sh1106_fill(ssd1306_t *ssd, bool value);
+void framebuffer_sh1106_fill_rect(ssd1306_t *ssd, int x, int y, int width, int height, bool value);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FRAMEBUFFER_H
@@ -0,0 +1,89 @@
+#ifndef FRAMEBUFFER_HPP
+#define FRAMEBUFFER_HPP
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include "ssd1306.h"
+
+// Draws into an ssd1306_t back buffer with the panel geometry fixed at compile time, so page,
+// bit and byte offsets are constant shifts, masks and multiplies instead of the runtime
+// width/pages math of ssd1306.c. Columns is the controller RAM width: an SH1106 has 132 and
+// shows the middle 128, so its drawing lands two columns in. The ssd1306_t must have been
+// initialised with width == Columns and the same height; dirty ranges are in RAM columns.
+// ssd1306_send_data only speaks SSD1306: the SH1106 has no 0x21/0x22 window addressing, so
+// FramebufferSh1106 is an off-screen drawing target, not something to send to a real SH1106.
+template <unsigned Width, unsigned Height, unsigned Columns = Width>
+class Framebuffer {
+    static_assert(Height % 8 == 0 && Height / 8 <= SSD1306_MAX_PAGES, "height must be whole pages");
+    static_assert(Columns >= Width && Columns <= 255, "RAM columns must hold the visible width");
+
+public:
+    static constexpr unsigned width = Width;
+    static constexpr unsigned height = Height;
+    static constexpr unsigned pages = Height >> 3;
+    static constexpr unsigned offset = (Columns - Width) / 2;
+    static constexpr std::size_t bytes = pages * Columns;
+
+    // Any other geometry would write past the back buffer (bytes is fixed, not ssd.bufsize)
+    explicit Framebuffer(ssd1306_t &ssd) : ssd_(ssd), pixels_(ssd.ram_buffer + 1) {
+        assert(ssd.width == Columns && ssd.height == Height);
+    }
+
+    void pixel(int x, int y, bool value) {
+        if (static_cast<unsigned>(x) >= Width || static_cast<unsigned>(y) >= Height) return;
+        unsigned page = static_cast<unsigned>(y) >> 3;
+        uint8_t bit = static_cast<uint8_t>(1u << (y & 7));
+        uint8_t &cell = pixels_[page * Columns + offset + x];
+        uint8_t old = cell;
+        cell = value ? static_cast<uint8_t>(cell | bit) : static_cast<uint8_t>(cell & ~bit);
+        if (cell != old) mark(page, offset + x, offset + x);
+    }
+
+    void fill(bool value) {
+        std::memset(pixels_, value ? 0xFF : 0x00, bytes);
+        for (unsigned page = 0; page < pages; ++page) mark(page, 0, Columns - 1);
+    }
+
+    void fill_rect(int x, int y, int w, int h, bool value) {
+        if (x < 0) { w += x; x = 0; }
+        if (y < 0) { h += y; y = 0; }
+        if (x + w > static_cast<int>(Width)) w = Width - x;
+        if (y + h > static_cast<int>(Height)) h = Height - y;
+        if (w <= 0 || h <= 0) return;
+
+        unsigned first_page = static_cast<unsigned>(y) >> 3;
+        unsigned last_page = static_cast<unsigned>(y + h - 1) >> 3;
+        uint8_t top = static_cast<uint8_t>(0xFF << (y & 7));
+        uint8_t bottom = static_cast<uint8_t>(0xFF >> (7 - ((y + h - 1) & 7)));
+        for (unsigned page = first_page; page <= last_page; ++page) {
+            uint8_t mask = 0xFF;
+            if (page == first_page) mask &= top;
+            if (page == last_page) mask &= bottom;
+            uint8_t *row = &pixels_[page * Columns + offset + x];
+            if (mask == 0xFF) {
+                std::memset(row, value ? 0xFF : 0x00, w);
+            } else if (value) {
+                for (int i = 0; i < w; ++i) row[i] |= mask;
+            } else {
+                for (int i = 0; i < w; ++i) row[i] &= static_cast<uint8_t>(~mask);
+            }
+            mark(page, offset + x, offset + x + w - 1);
+        }
+    }
+
+private:
+    void mark(unsigned page, unsigned x0, unsigned x1) {
+        if (x0 < ssd_.dirty_min[page]) ssd_.dirty_min[page] = static_cast<uint8_t>(x0);
+        if (x1 > ssd_.dirty_max[page]) ssd_.dirty_max[page] = static_cast<uint8_t>(x1);
+    }
+
+    ssd1306_t &ssd_;
+    uint8_t *pixels_;
+};
+
+using Framebuffer128x64 = Framebuffer<128, 64>;
+using Framebuffer128x32 = Framebuffer<128, 32>;
+using FramebufferSh1106 = Framebuffer<128, 64, 132>;
+
+#endif // FRAMEBUFFER_HPP
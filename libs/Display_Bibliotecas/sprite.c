@@ -0,0 +1,40 @@
+#include "sprite.h"
+
+void sprite_draw(ssd1306_t *ssd, const sprite_t *sprite, uint8_t frame, int x, int y) {
+    int first = x < 0 ? -x : 0;
+    int last = sprite->width;
+    if (x + last > ssd->width) last = ssd->width - x;
+    if (first >= last || y >= ssd->height || y + sprite->height <= 0) return;
+
+    int src_pages = (sprite->height + 7) >> 3;
+    int frame_bytes = src_pages * sprite->width;
+    int offset = sprite->frames ? (frame % sprite->frames) * frame_bytes : 0;
+    const uint8_t *pixels = sprite->pixels + offset;
+    const uint8_t *mask = sprite->mask ? sprite->mask + offset : NULL;
+
+    // Floor division, so a sprite partly above the screen still lines up with its pages
+    int top_page = y >= 0 ? y >> 3 : -((7 - y) >> 3);
+    int shift = y - top_page * 8;
+    uint8_t *buffer = &ssd->ram_buffer[1];
+
+    for (int p = 0; p < src_pages; ++p) {
+        // Rows past the sprite height in its last page belong to nothing
+        uint8_t rows = (p == src_pages - 1 && (sprite->height & 7)) ? (uint8_t)(0xFF >> (8 - (sprite->height & 7))) : 0xFF;
+        const uint8_t *src = pixels + p * sprite->width;
+        const uint8_t *own = mask ? mask + p * sprite->width : NULL;
+        int low_page = top_page + p, high_page = low_page + 1;
+        uint8_t *low = low_page >= 0 && low_page < ssd->pages ? &buffer[low_page * ssd->width + x] : NULL;
+        // A short last page may not reach the page below at all
+        bool spills = ((uint16_t)rows << shift) >> 8;
+        uint8_t *high = spills && high_page >= 0 && high_page < ssd->pages ? &buffer[high_page * ssd->width + x] : NULL;
+
+        for (int c = first; c < last; ++c) {
+            uint16_t m = (uint16_t)((own ? own[c] : 0xFF) & rows) << shift;
+            uint16_t v = (uint16_t)(src[c] & (m >> shift)) << shift;
+            if (low) low[c] = (uint8_t)((low[c] & ~m) | v);
+            if (high) high[c] = (uint8_t)((high[c] & ~(m >> 8)) | (v >> 8));
+        }
+        if (low) ssd1306_mark_dirty(ssd, low_page, x + first, x + last - 1);
+        if (high) ssd1306_mark_dirty(ssd, high_page, x + first, x + last - 1);
+    }
+}
@@ -0,0 +1,34 @@
+#ifndef SPRITE_H
+#define SPRITE_H
+
+#include <stdint.h>
+#include "ssd1306.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Page-packed 1bpp sprite in the SSD1306 RAM layout: each frame is (height + 7) / 8 rows of
+// width column bytes, bit 0 on top. A set mask bit means the sprite owns that pixel and the
+// screen takes the sprite's value there; elsewhere the screen is left alone. Without a mask
+// the sprite owns its whole rectangle. Pointing mask at pixels makes clear pixels transparent.
+typedef struct {
+    uint8_t width;
+    uint8_t height;
+    uint8_t frames;
+    const uint8_t *pixels;
+    const uint8_t *mask;
+} sprite_t;
+
+#define SPRITE_FRAME_BYTES(width, height) ((width) * (((height) + 7) / 8))
+
+// Clips once against the screen, then shifts each sprite page across the two screen pages
+// it straddles. Any x/y, including off-screen; frame wraps around the frame count, and a
+// frame count of 0 draws frame 0.
+void sprite_draw(ssd1306_t *ssd, const sprite_t *sprite, uint8_t frame, int x, int y);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SPRITE_H
@@ -1,7 +1,14 @@
 #include "ssd1306.h"
-#include "font.h"
+#include "font_atlas.h"
 #include <stdlib.h>
+#include <string.h>
 #include "hardware/i2c.h"
+#include "hardware/dma.h"
+
+static void ssd1306_clear_dirty(ssd1306_t *ssd) {
+    memset(ssd->dirty_min, 0xFF, sizeof(ssd->dirty_min));
+    memset(ssd->dirty_max, 0x00, sizeof(ssd->dirty_max));
+}
 
 void ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c) {
     ssd->width = width;
@@ -10,92 +17,397 @@ void ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_v
     ssd->address = address;
     ssd->i2c_port = i2c;
     ssd->bufsize = ssd->pages * ssd->width + 1;
-    ssd->ram_buffer = calloc(ssd->bufsize, sizeof(uint8_t));
+    // Three spare bytes put the pixels after the control byte on a word boundary (compositor.c)
+    uint8_t *raw = calloc(ssd->bufsize + 3, sizeof(uint8_t));
+    ssd->ram_buffer = raw != NULL ? raw + 3 : NULL;
     if (ssd->ram_buffer != NULL) {
         ssd->ram_buffer[0] = 0x40; // Co = 0, D/C = 1
     }
-    ssd->port_buffer[0] = 0x80; // Co = 1, D/C = 0
-}
-
-void ssd1306_config(ssd1306_t *ssd) {
-    ssd1306_command(ssd, 0xAE); // Display off
-    ssd1306_command(ssd, 0x20); // Memory mode
-    ssd1306_command(ssd, 0x00); // Horizontal addressing mode
-    ssd1306_command(ssd, 0x40); // Start line
-    ssd1306_command(ssd, 0xA1); // Segment remap
-    ssd1306_command(ssd, 0xA8); // Multiplex ratio
-    ssd1306_command(ssd, ssd->height - 1);
-    ssd1306_command(ssd, 0xC8); // COM output scan direction
-    ssd1306_command(ssd, 0xD3); // Display offset
-    ssd1306_command(ssd, 0x00);
-    ssd1306_command(ssd, 0xDA); // COM pin config
-    ssd1306_command(ssd, 0x12);
-    ssd1306_command(ssd, 0xD5); // Display clock divide ratio
-    ssd1306_command(ssd, 0x80);
-    ssd1306_command(ssd, 0xD9); // Pre-charge period
-    ssd1306_command(ssd, 0xF1);
-    ssd1306_command(ssd, 0xDB); // VCOM deselect level
-    ssd1306_command(ssd, 0x30);
-    ssd1306_command(ssd, 0x81); // Contrast control
-    ssd1306_command(ssd, 0xFF);
-    ssd1306_command(ssd, 0xA4); // Entire display on
-    ssd1306_command(ssd, 0xA6); // Normal display
-    ssd1306_command(ssd, 0x8D); // Charge pump setting
-    ssd1306_command(ssd, 0x14);
-    ssd1306_command(ssd, 0xAF); // Display on
+    ssd->front_buffer = calloc(ssd->bufsize - 1, sizeof(uint8_t));
+    ssd->front_valid = false; // Panel RAM is undefined after power-up
+    ssd1306_clear_dirty(ssd);
+    ssd->baudrate = 0;
+    ssd->fallback_baudrate = 0;
+    ssd->bus_errors = 0;
+    ssd->reconfigure = false;
+    ssd->dma_channel = -1;
+    ssd->tx_words = NULL;
+    ssd->tx_capacity = 0;
+    ssd->busy = false;
+    memset(&ssd->scroll, 0, sizeof(ssd->scroll));
+    ssd->contrast = SSD1306_CONTRAST_DEFAULT; // What ssd1306_config sends
+    ssd->inverted = false;
+}
+
+// NAK or bus error: the panel gets a full frame next time, and with a fallback rate the bus
+// drops to it and the controller is configured again, since a cut command list may have left
+// it waiting for arguments.
+static void ssd1306_bus_error(ssd1306_t *ssd) {
+    ssd->bus_errors++;
+    ssd->front_valid = false;
+    if (ssd->fallback_baudrate && ssd->baudrate > ssd->fallback_baudrate) {
+        ssd->baudrate = ssd->fallback_baudrate;
+        i2c_set_baudrate(ssd->i2c_port, ssd->baudrate);
+        ssd->reconfigure = true;
+    }
+}
+
+// Returns false if the panel did not take the sequence even at the fallback rate
+bool ssd1306_config(ssd1306_t *ssd) {
+    const uint8_t commands[] = {
+        0xAE,       // Display off
+        0x2E,       // Scroll off
+        0x20, 0x00, // Memory mode: horizontal addressing
+        0x40,       // Start line
+        0xA1,       // Segment remap
+        0xA8, (uint8_t)(ssd->height - 1), // Multiplex ratio
+        0xC8,       // COM output scan direction
+        0xD3, 0x00, // Display offset
+        0xDA, (uint8_t)(ssd->height == 32 ? 0x02 : 0x12), // COM pins: sequential for 32 rows, alternative for 64
+        0xD5, 0x80, // Display clock divide ratio
+        0xD9, 0xF1, // Pre-charge period
+        0xDB, 0x30, // VCOM deselect level
+        0x81, ssd->contrast, // Contrast control
+        0xA4,       // Entire display on
+        ssd->inverted ? 0xA7 : 0xA6, // Normal or inverse display
+        0x8D, 0x14, // Charge pump setting
+        0xAF,       // Display on
+    };
+    ssd->scroll.direction = SSD1306_SCROLL_OFF;
+    ssd->front_valid = false;
+    do {
+        ssd->reconfigure = false;
+        if (ssd1306_commands(ssd, commands, sizeof(commands))) return true;
+    } while (ssd->reconfigure);
+    return false;
+}
+
+// Sets the I2C rate for the panel, e.g. 1 MHz Fast-mode Plus with 400 kHz as the fallback
+void ssd1306_set_baudrate(ssd1306_t *ssd, uint32_t baudrate, uint32_t fallback_baudrate) {
+    ssd1306_wait(ssd);
+    ssd->baudrate = baudrate;
+    ssd->fallback_baudrate = fallback_baudrate;
+    i2c_set_baudrate(ssd->i2c_port, baudrate);
+}
+
+// Sends the whole list as one transaction behind a single control byte
+bool ssd1306_commands(ssd1306_t *ssd, const uint8_t *commands, size_t count) {
+    uint8_t buffer[1 + SSD1306_MAX_COMMANDS];
+    if (count > SSD1306_MAX_COMMANDS) return false;
+    ssd1306_wait(ssd);
+    buffer[0] = 0x00; // Co = 0, D/C = 0
+    memcpy(&buffer[1], commands, count);
+    if (i2c_write_blocking(ssd->i2c_port, ssd->address, buffer, count + 1, false) == (int)(count + 1)) return true;
+    ssd1306_bus_error(ssd);
+    return false;
 }
 
 void ssd1306_command(ssd1306_t *ssd, uint8_t command) {
-    ssd->port_buffer[1] = command;
-    i2c_write_blocking(ssd->i2c_port, ssd->address, ssd->port_buffer, 2, false);
+    ssd1306_commands(ssd, &command, 1);
+}
+
+void ssd1306_mark_dirty(ssd1306_t *ssd, uint8_t page, uint8_t x0, uint8_t x1) {
+    if (x0 < ssd->dirty_min[page]) ssd->dirty_min[page] = x0;
+    if (x1 > ssd->dirty_max[page]) ssd->dirty_max[page] = x1;
+}
+
+static bool ssd1306_send_full(ssd1306_t *ssd) {
+    const uint8_t address[] = {
+        0x21, 0, ssd->width - 1, // Column address
+        0x22, 0, ssd->pages - 1, // Page address
+    };
+    if (!ssd1306_commands(ssd, address, sizeof(address))) return false;
+    if (i2c_write_blocking(ssd->i2c_port, ssd->address, ssd->ram_buffer, ssd->bufsize, false) == ssd->bufsize) return true;
+    ssd1306_bus_error(ssd);
+    return false;
+}
+
+static bool ssd1306_send_window(ssd1306_t *ssd, const ssd1306_window_t *win) {
+    const uint8_t address[] = {
+        0x21, win->x0, win->x1,     // Column address
+        0x22, win->page, win->page, // Page address
+    };
+    if (!ssd1306_commands(ssd, address, sizeof(address))) return false;
+
+    // Borrow the byte just before the window for the data control byte
+    uint8_t *data = &ssd->ram_buffer[win->page * ssd->width + win->x0];
+    uint8_t saved = *data;
+    int length = win->x1 - win->x0 + 2;
+    *data = 0x40;
+    int written = i2c_write_blocking(ssd->i2c_port, ssd->address, data, length, false);
+    *data = saved;
+    if (written == length) return true;
+    ssd1306_bus_error(ssd);
+    return false;
+}
+
+// Splits the dirty ranges into windows of bytes that differ from the panel.
+// Returns the number of windows, or -1 when a full frame would be cheaper.
+static int ssd1306_collect_windows(ssd1306_t *ssd, ssd1306_window_t *windows) {
+    int count = 0;
+    uint32_t cost = 0;
+    for (uint8_t page = 0; page < ssd->pages; ++page) {
+        if (ssd->dirty_min[page] > ssd->dirty_max[page]) continue;
+        const uint8_t *cur = &ssd->ram_buffer[1 + page * ssd->width];
+        const uint8_t *old = &ssd->front_buffer[page * ssd->width];
+        uint16_t x = ssd->dirty_min[page];
+        uint16_t last = ssd->dirty_max[page];
+        while (x <= last) {
+            while (x <= last && cur[x] == old[x]) ++x;
+            if (x > last) break;
+
+            // Extend the window across gaps that are cheaper to resend than to reopen
+            uint16_t start = x, end = x;
+            while (x <= last && x - end <= SSD1306_WINDOW_OVERHEAD) {
+                if (cur[x] != old[x]) end = x;
+                ++x;
+            }
+            if (count == SSD1306_MAX_WINDOWS) return -1;
+            windows[count].page = page;
+            windows[count].x0 = start;
+            windows[count].x1 = end;
+            ++count;
+            cost += SSD1306_WINDOW_OVERHEAD + end - start + 1;
+        }
+    }
+    return cost >= (uint32_t)SSD1306_WINDOW_OVERHEAD + ssd->bufsize ? -1 : count;
+}
+
+// Moves the back buffer changes into the front buffer and returns the
+// windows to transmit, or -1 when the whole frame has to go out.
+static int ssd1306_present(ssd1306_t *ssd, ssd1306_window_t *windows) {
+    if (ssd->reconfigure) ssd1306_config(ssd);
+    int count = ssd->front_valid ? ssd1306_collect_windows(ssd, windows) : -1;
+    if (count != 0 && ssd->scroll.direction != SSD1306_SCROLL_OFF) {
+        // GDDRAM must not be written while scrolling; an unchanged frame leaves it running
+        ssd1306_scroll_stop(ssd);
+        count = -1;
+    }
+
+    if (count < 0) {
+        memcpy(ssd->front_buffer, &ssd->ram_buffer[1], ssd->bufsize - 1);
+        ssd->front_valid = true;
+    } else {
+        for (int i = 0; i < count; ++i) {
+            const ssd1306_window_t *win = &windows[i];
+            uint16_t offset = win->page * ssd->width + win->x0;
+            memcpy(&ssd->front_buffer[offset], &ssd->ram_buffer[1 + offset], win->x1 - win->x0 + 1);
+        }
+    }
+    ssd1306_clear_dirty(ssd);
+    return count;
 }
 
 void ssd1306_send_data(ssd1306_t *ssd) {
-    ssd1306_command(ssd, 0x21); // Column address
-    ssd1306_command(ssd, 0);
-    ssd1306_command(ssd, ssd->width - 1);
-    ssd1306_command(ssd, 0x22); // Page address
-    ssd1306_command(ssd, 0);
-    ssd1306_command(ssd, ssd->pages - 1);
-    i2c_write_blocking(ssd->i2c_port, ssd->address, ssd->ram_buffer, ssd->bufsize, false);
+    ssd1306_window_t windows[SSD1306_MAX_WINDOWS];
+    ssd1306_wait(ssd);
+    int count = ssd1306_present(ssd, windows);
+
+    if (count < 0) {
+        ssd1306_send_full(ssd);
+    } else {
+        for (int i = 0; i < count; ++i) {
+            // After an error the next flush resends everything anyway
+            if (!ssd1306_send_window(ssd, &windows[i])) break;
+        }
+    }
+}
+
+bool ssd1306_init_dma(ssd1306_t *ssd) {
+    int channel = dma_claim_unused_channel(false);
+    if (channel < 0) return false;
+
+    // Worst case is a full frame plus one set of address commands
+    ssd->tx_capacity = ssd->bufsize + SSD1306_WINDOW_OVERHEAD;
+    ssd->tx_words = calloc(ssd->tx_capacity, sizeof(uint16_t));
+    if (ssd->tx_words == NULL) {
+        dma_channel_unclaim(channel);
+        return false;
+    }
+
+    // 16-bit writes so the STOP/RESTART bits of DATA_CMD can be driven per byte
+    dma_channel_config cfg = dma_channel_get_default_config(channel);
+    channel_config_set_transfer_data_size(&cfg, DMA_SIZE_16);
+    channel_config_set_read_increment(&cfg, true);
+    channel_config_set_write_increment(&cfg, false);
+    channel_config_set_dreq(&cfg, i2c_get_dreq(ssd->i2c_port, true));
+    dma_channel_configure(channel, &cfg, &i2c_get_hw(ssd->i2c_port)->data_cmd, ssd->tx_words, 0, false);
+    ssd->dma_channel = channel;
+    return true;
+}
+
+// Appends one addressed window of the front buffer to the DATA_CMD stream.
+// Each window is a command transaction followed by a data transaction, chained
+// with repeated STARTs so the whole flush is a single DMA transfer.
+static uint16_t ssd1306_stream_window(ssd1306_t *ssd, uint16_t n, uint8_t page0, uint8_t page1, uint8_t x0, uint8_t x1) {
+    uint16_t *out = ssd->tx_words;
+    out[n] = 0x00 | (n ? I2C_IC_DATA_CMD_RESTART_BITS : 0); // Co = 0, D/C = 0
+    ++n;
+    out[n++] = 0x21; // Column address
+    out[n++] = x0;
+    out[n++] = x1;
+    out[n++] = 0x22; // Page address
+    out[n++] = page0;
+    out[n++] = page1;
+    out[n++] = 0x40 | I2C_IC_DATA_CMD_RESTART_BITS; // Co = 0, D/C = 1
+    for (uint8_t page = page0; page <= page1; ++page) {
+        const uint8_t *src = &ssd->front_buffer[page * ssd->width];
+        for (uint16_t x = x0; x <= x1; ++x) {
+            out[n++] = src[x];
+        }
+    }
+    return n;
+}
+
+void ssd1306_send_data_async(ssd1306_t *ssd) {
+    if (ssd->dma_channel < 0) {
+        ssd1306_send_data(ssd);
+        return;
+    }
+
+    ssd1306_window_t windows[SSD1306_MAX_WINDOWS];
+    ssd1306_wait(ssd);
+    int count = ssd1306_present(ssd, windows);
+
+    uint16_t n = 0;
+    if (count < 0) {
+        n = ssd1306_stream_window(ssd, n, 0, ssd->pages - 1, 0, ssd->width - 1);
+    } else {
+        for (int i = 0; i < count; ++i) {
+            n = ssd1306_stream_window(ssd, n, windows[i].page, windows[i].page, windows[i].x0, windows[i].x1);
+        }
+    }
+    if (n == 0) return;
+    ssd->tx_words[n - 1] |= I2C_IC_DATA_CMD_STOP_BITS;
+
+    i2c_hw_t *hw = i2c_get_hw(ssd->i2c_port);
+    hw->enable = 0;
+    hw->tar = ssd->address;
+    hw->enable = 1;
+    (void)hw->clr_stop_det;
+    ssd->busy = true;
+    dma_channel_transfer_from_buffer_now(ssd->dma_channel, ssd->tx_words, n);
+}
+
+bool ssd1306_busy(ssd1306_t *ssd) {
+    if (!ssd->busy) return false;
+
+    i2c_hw_t *hw = i2c_get_hw(ssd->i2c_port);
+    uint32_t status = hw->raw_intr_stat;
+    if (status & I2C_IC_RAW_INTR_STAT_TX_ABRT_BITS) {
+        // NAK or arbitration loss: drop the rest and resend a full frame next time
+        dma_channel_abort(ssd->dma_channel);
+        (void)hw->clr_tx_abrt;
+        ssd->busy = false;
+        ssd1306_bus_error(ssd);
+        return false;
+    }
+    if (dma_channel_is_busy(ssd->dma_channel)) return true;
+    if (!(status & I2C_IC_RAW_INTR_STAT_STOP_DET_BITS)) return true;
+
+    (void)hw->clr_stop_det;
+    ssd->busy = false;
+    return false;
+}
+
+void ssd1306_wait(ssd1306_t *ssd) {
+    while (ssd1306_busy(ssd)) {
+        tight_loop_contents();
+    }
 }
 
 void ssd1306_pixel(ssd1306_t *ssd, uint8_t x, uint8_t y, bool value) {
-    uint16_t index = (y / 8) * ssd->width + x + 1;
+    if (x >= ssd->width || y >= ssd->height) return;
+    uint8_t page = y / 8;
+    uint16_t index = page * ssd->width + x + 1;
     uint8_t pixel = y % 8;
+    uint8_t old = ssd->ram_buffer[index];
     if (value) {
         ssd->ram_buffer[index] |= (1 << pixel);
     } else {
         ssd->ram_buffer[index] &= ~(1 << pixel);
     }
+    if (ssd->ram_buffer[index] != old) {
+        ssd1306_mark_dirty(ssd, page, x, x);
+    }
 }
 
 void ssd1306_fill(ssd1306_t *ssd, bool value) {
-    for (uint8_t y = 0; y < ssd->height; ++y) {
-        for (uint8_t x = 0; x < ssd->width; ++x) {
-            ssd1306_pixel(ssd, x, y, value);
+    memset(&ssd->ram_buffer[1], value ? 0xFF : 0x00, ssd->bufsize - 1);
+    for (uint8_t page = 0; page < ssd->pages; ++page) {
+        ssd1306_mark_dirty(ssd, page, 0, ssd->width - 1);
+    }
+}
+
+// Replaces the back buffer with a frame rendered elsewhere (page order, no control byte)
+void ssd1306_load_frame(ssd1306_t *ssd, const uint8_t *pixels) {
+    memcpy(&ssd->ram_buffer[1], pixels, ssd->bufsize - 1);
+    for (uint8_t page = 0; page < ssd->pages; ++page) {
+        ssd1306_mark_dirty(ssd, page, 0, ssd->width - 1);
+    }
+}
+
+void ssd1306_fill_rect(ssd1306_t *ssd, int x, int y, int width, int height, bool value) {
+    // Clip once, then work on whole column bytes one page at a time
+    if (x < 0) { width += x; x = 0; }
+    if (y < 0) { height += y; y = 0; }
+    if (x + width > ssd->width) width = ssd->width - x;
+    if (y + height > ssd->height) height = ssd->height - y;
+    if (width <= 0 || height <= 0) return;
+
+    int y_last = y + height - 1;
+    for (int page = y / 8; page <= y_last / 8; ++page) {
+        int first_bit = (page == y / 8) ? y % 8 : 0;
+        int last_bit = (page == y_last / 8) ? y_last % 8 : 7;
+        uint8_t mask = (uint8_t)((0xFF << first_bit) & (0xFF >> (7 - last_bit)));
+        uint8_t *row = &ssd->ram_buffer[1 + page * ssd->width + x];
+
+        if (mask == 0xFF) {
+            memset(row, value ? 0xFF : 0x00, width);
+        } else if (value) {
+            for (int i = 0; i < width; ++i) row[i] |= mask;
+        } else {
+            for (int i = 0; i < width; ++i) row[i] &= ~mask;
         }
+        ssd1306_mark_dirty(ssd, page, x, x + width - 1);
     }
 }
 
-void ssd1306_draw_small_number(ssd1306_t *ssd, char c, uint8_t x, uint8_t y) {
-    if (c >= '0' && c <= '9') {
-        // Índice na fonte para o número correspondente
-        uint16_t index = ((c - '0') * 5) + (68 * 8); // Baseado na estrutura da fonte
-
-        for (uint8_t i = 0; i < 5; ++i) {
-            uint8_t line = font[index + i]; // Linha da matriz 5x5 do número
-            for (uint8_t j = 0; j < 5; ++j) {
-                // Inverter a ordem dos bits ao desenhar
-                if ((line >> (4 - j)) & 0x01) {
-                    ssd1306_pixel(ssd, x + j, y + i, true);
-                }
+// Writes page-packed glyph columns with their top row at y. Row-aligned text
+// is a plain copy; otherwise each column is shifted across two pages.
+static void ssd1306_blit_columns(ssd1306_t *ssd, const uint8_t *columns, int width, uint8_t x, uint8_t y, bool opaque) {
+    if (y >= ssd->height || x >= ssd->width) return;
+    if (x + width > ssd->width) width = ssd->width - x;
+
+    uint8_t page = y / 8;
+    uint8_t shift = y % 8;
+    uint8_t *row = &ssd->ram_buffer[1 + page * ssd->width + x];
+
+    if (shift == 0 && opaque) {
+        memcpy(row, columns, width);
+    } else {
+        uint8_t keep = opaque ? (uint8_t)~(0xFF << shift) : 0xFF;
+        for (int i = 0; i < width; ++i) {
+            row[i] = (row[i] & keep) | (uint8_t)(columns[i] << shift);
+        }
+        if (shift && page + 1 < ssd->pages) {
+            uint8_t *next = row + ssd->width;
+            uint8_t keep_next = opaque ? (uint8_t)~(0xFF >> (8 - shift)) : 0xFF;
+            for (int i = 0; i < width; ++i) {
+                next[i] = (next[i] & keep_next) | (columns[i] >> (8 - shift));
             }
+            ssd1306_mark_dirty(ssd, page + 1, x, x + width - 1);
         }
     }
+    ssd1306_mark_dirty(ssd, page, x, x + width - 1);
 }
 
-
+void ssd1306_draw_small_number(ssd1306_t *ssd, char c, uint8_t x, uint8_t y) {
+    if (c >= '0' && c <= '9') {
+        // Small digits only set pixels, whatever is under them stays
+        ssd1306_blit_columns(ssd, font_atlas_small[c - '0'], FONT_ATLAS_SMALL_WIDTH, x, y, false);
+    }
+}
 
 void ssd1306_draw_char(ssd1306_t *ssd, char c, uint8_t x, uint8_t y, bool use_small_numbers) {
     if (use_small_numbers && c >= '0' && c <= '9') {
@@ -103,41 +415,9 @@ void ssd1306_draw_char(ssd1306_t *ssd, char c, uint8_t x, uint8_t y, bool use_sm
         return;
     }
 
-    uint16_t index = 0;
-    bool rotate = false; // Flag para rotação
-
-    if (c >= '0' && c <= '9') {
-        index = (c - '0' + 1) * 8;
-    } else if (c >= 'A' && c <= 'Z') {
-        index = (c - 'A' + 11) * 8;
-    } else if (c >= 'a' && c <= 'z') {
-        index = (c - 'a' + 37) * 8;
-    } else if (c == ':') {
-        index = 64 * 8; // Índice para ':'
-        rotate = true;
-    } else if (c == '.') {
-        index = 65 * 8; // Índice para '.'
-        rotate = true;
-    } else if (c == '>') {
-        index = 66 * 8; // Índice para '>'
-        rotate = true;
-    } else if (c == '-') {
-        index = 67 * 8; // Índice para '-'
-        rotate = true;
-    }
-
-    for (uint8_t i = 0; i < 8; ++i) {
-        uint8_t line = font[index + i];
-        for (uint8_t j = 0; j < 8; ++j) {
-            if (rotate) {
-                // Rotaciona 90° para símbolos especiais
-                ssd1306_pixel(ssd, x + (7 - j), y + i, (line >> j) & 0x01);
-            } else {
-                // Caracteres normais sem rotação
-                ssd1306_pixel(ssd, x + i, y + j, (line >> j) & 0x01);
-            }
-        }
-    }
+    // Anything outside the atlas renders as the blank glyph
+    if (c < FONT_ATLAS_FIRST || c > FONT_ATLAS_LAST) c = ' ';
+    ssd1306_blit_columns(ssd, font_atlas[c - FONT_ATLAS_FIRST], FONT_ATLAS_WIDTH, x, y, true);
 }
 
 void ssd1306_draw_string(ssd1306_t *ssd, const char *str, uint8_t x, uint8_t y, bool use_small_numbers) {
@@ -163,21 +443,14 @@ void ssd1306_draw_string(ssd1306_t *ssd, const char *str, uint8_t x, uint8_t y,
 }
 
 void ssd1306_rect(ssd1306_t *ssd, uint8_t top, uint8_t left, uint8_t width, uint8_t height, bool value, bool fill) {
-    for (uint8_t x = left; x < left + width; ++x) {
-        ssd1306_pixel(ssd, x, top, value);
-        ssd1306_pixel(ssd, x, top + height - 1, value);
-    }
-    for (uint8_t y = top; y < top + height; ++y) {
-        ssd1306_pixel(ssd, left, y, value);
-        ssd1306_pixel(ssd, left + width - 1, y, value);
-    }
     if (fill) {
-        for (uint8_t x = left + 1; x < left + width - 1; ++x) {
-            for (uint8_t y = top + 1; y < top + height - 1; ++y) {
-                ssd1306_pixel(ssd, x, y, value);
-            }
-        }
+        ssd1306_fill_rect(ssd, left, top, width, height, value);
+        return;
     }
+    ssd1306_fill_rect(ssd, left, top, width, 1, value);
+    ssd1306_fill_rect(ssd, left, top + height - 1, width, 1, value);
+    ssd1306_fill_rect(ssd, left, top, 1, height, value);
+    ssd1306_fill_rect(ssd, left + width - 1, top, 1, height, value);
 }
 
 void ssd1306_line(ssd1306_t *ssd, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, bool value) {
@@ -194,13 +467,69 @@ void ssd1306_line(ssd1306_t *ssd, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1
 }
 
 void ssd1306_hline(ssd1306_t *ssd, uint8_t x0, uint8_t x1, uint8_t y, bool value) {
-    for (uint8_t x = x0; x <= x1; ++x) {
-        ssd1306_pixel(ssd, x, y, value);
-    }
+    ssd1306_fill_rect(ssd, x0, y, x1 - x0 + 1, 1, value);
 }
 
 void ssd1306_vline(ssd1306_t *ssd, uint8_t x, uint8_t y0, uint8_t y1, bool value) {
-    for (uint8_t y = y0; y <= y1; ++y) {
-        ssd1306_pixel(ssd, x, y, value);
+    ssd1306_fill_rect(ssd, x, y0, 1, y1 - y0 + 1, value);
+}
+
+void ssd1306_scroll_stop(ssd1306_t *ssd) {
+    if (ssd->scroll.direction == SSD1306_SCROLL_OFF) return;
+    const uint8_t commands[] = {
+        0x2E, // Deactivate scroll
+        0x40, // Start line back to 0 after a diagonal scroll
+    };
+    bool diagonal = ssd->scroll.direction >= SSD1306_SCROLL_DIAGONAL_RIGHT;
+    ssd1306_commands(ssd, commands, diagonal ? 2 : 1);
+    ssd->scroll.direction = SSD1306_SCROLL_OFF;
+    // The panel RAM stays where the scroll left it, so the next flush resends every byte
+    ssd->front_valid = false;
+}
+
+void ssd1306_scroll(ssd1306_t *ssd, const ssd1306_scroll_t *scroll) {
+    if (scroll->direction == SSD1306_SCROLL_OFF) {
+        ssd1306_scroll_stop(ssd);
+        return;
+    }
+    if (memcmp(scroll, &ssd->scroll, sizeof(*scroll)) == 0) return;
+
+    // Changing the setup of a running scroll is not allowed
+    ssd1306_scroll_stop(ssd);
+    static const uint8_t setup[] = { 0x00, 0x26, 0x27, 0x29, 0x2A };
+    uint8_t commands[12];
+    size_t n = 0;
+    bool diagonal = scroll->direction >= SSD1306_SCROLL_DIAGONAL_RIGHT;
+    if (diagonal) {
+        commands[n++] = 0xA3; // Vertical scroll area: the whole panel
+        commands[n++] = 0;
+        commands[n++] = ssd->height;
     }
+    commands[n++] = setup[scroll->direction];
+    commands[n++] = 0x00; // Dummy
+    commands[n++] = scroll->page0;
+    commands[n++] = scroll->interval;
+    commands[n++] = scroll->page1;
+    if (diagonal) {
+        commands[n++] = scroll->vertical;
+    } else {
+        commands[n++] = 0x00; // Dummy
+        commands[n++] = 0xFF;
+    }
+    commands[n++] = 0x2F; // Activate scroll
+    if (ssd1306_commands(ssd, commands, n)) ssd->scroll = *scroll;
+}
+
+void ssd1306_contrast(ssd1306_t *ssd, uint8_t level) {
+    if (level == ssd->contrast) return;
+    const uint8_t commands[] = { 0x81, level }; // Contrast control
+    // Kept even if the write fails: a reconfiguration after the error sends it again
+    ssd->contrast = level;
+    ssd1306_commands(ssd, commands, sizeof(commands));
+}
+
+void ssd1306_invert(ssd1306_t *ssd, bool inverted) {
+    if (inverted == ssd->inverted) return;
+    ssd->inverted = inverted;
+    ssd1306_command(ssd, inverted ? 0xA7 : 0xA6);
 }
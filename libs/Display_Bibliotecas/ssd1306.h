@@ -1,10 +1,53 @@
 #ifndef SSD1306_H
 #define SSD1306_H
 
+#include <stddef.h>
 #include <stdint.h>
 #include <stdbool.h>
 #include "hardware/i2c.h"
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SSD1306_MAX_PAGES 8       // 64 rows / 8
+#define SSD1306_MAX_WINDOWS 32    // Partial windows per flush before falling back to a full frame
+#define SSD1306_WINDOW_OVERHEAD 20 // Bus bytes spent opening a window (address commands + data header)
+#define SSD1306_CONTRAST_DEFAULT 0xFF
+#define SSD1306_MAX_COMMANDS 32   // Command bytes in one ssd1306_commands transaction
+
+typedef enum {
+    SSD1306_SCROLL_OFF,
+    SSD1306_SCROLL_RIGHT,
+    SSD1306_SCROLL_LEFT,
+    SSD1306_SCROLL_DIAGONAL_RIGHT,           // Vertical plus horizontal
+    SSD1306_SCROLL_DIAGONAL_LEFT,
+} ssd1306_scroll_direction_t;
+
+// Frame interval codes of the scroll setup commands (panel frames per step)
+#define SSD1306_SCROLL_5_FRAMES   0x00
+#define SSD1306_SCROLL_64_FRAMES  0x01
+#define SSD1306_SCROLL_128_FRAMES 0x02
+#define SSD1306_SCROLL_256_FRAMES 0x03
+#define SSD1306_SCROLL_3_FRAMES   0x04
+#define SSD1306_SCROLL_4_FRAMES   0x05
+#define SSD1306_SCROLL_25_FRAMES  0x06
+#define SSD1306_SCROLL_2_FRAMES   0x07
+
+typedef struct {
+    uint8_t direction;                       // ssd1306_scroll_direction_t
+    uint8_t page0;                           // Pages that move horizontally
+    uint8_t page1;
+    uint8_t interval;                        // SSD1306_SCROLL_*_FRAMES
+    uint8_t vertical;                        // Rows per step, diagonal scrolls only
+} ssd1306_scroll_t;
+
+typedef struct {
+    uint8_t page;
+    uint8_t x0;
+    uint8_t x1;
+} ssd1306_window_t;
+
 typedef struct {
     uint8_t width;
     uint8_t height;
@@ -12,25 +55,59 @@ typedef struct {
     uint8_t address;
     i2c_inst_t *i2c_port;
     uint16_t bufsize;
-    uint8_t *ram_buffer;
-    uint8_t port_buffer[2];
+    uint8_t *ram_buffer;                     // Back buffer: drawing target
+    uint8_t *front_buffer;                   // Front buffer: last frame handed to the panel (no control byte)
+    bool front_valid;                        // False until the first full frame reaches the panel
+    uint8_t dirty_min[SSD1306_MAX_PAGES];    // Touched column range per page, min > max when clean
+    uint8_t dirty_max[SSD1306_MAX_PAGES];
+    uint32_t baudrate;                       // Rate set by ssd1306_set_baudrate, 0 if left to the caller
+    uint32_t fallback_baudrate;              // Rate to drop to after a NAK or bus error, 0 for none
+    uint32_t bus_errors;                     // NAKs and aborted transfers
+    bool reconfigure;                        // Next flush reruns ssd1306_config first
+    int dma_channel;                         // -1 when async transfers are not available
+    uint16_t *tx_words;                      // I2C DATA_CMD stream fed to the TX FIFO by DMA
+    uint16_t tx_capacity;
+    volatile bool busy;                      // Async transfer in flight
+    ssd1306_scroll_t scroll;                 // Running hardware scroll, direction OFF when stopped
+    uint8_t contrast;                        // Last values sent to the panel
+    bool inverted;
 } ssd1306_t;
 
 // Funções existentes permanecem iguais
 void ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c);
-void ssd1306_config(ssd1306_t *ssd);
+bool ssd1306_config(ssd1306_t *ssd);
+void ssd1306_set_baudrate(ssd1306_t *ssd, uint32_t baudrate, uint32_t fallback_baudrate);
+bool ssd1306_commands(ssd1306_t *ssd, const uint8_t *commands, size_t count);
 void ssd1306_command(ssd1306_t *ssd, uint8_t command);
 void ssd1306_send_data(ssd1306_t *ssd);
+bool ssd1306_init_dma(ssd1306_t *ssd);
+void ssd1306_send_data_async(ssd1306_t *ssd);
+bool ssd1306_busy(ssd1306_t *ssd);
+void ssd1306_wait(ssd1306_t *ssd);
+void ssd1306_mark_dirty(ssd1306_t *ssd, uint8_t page, uint8_t x0, uint8_t x1);
 void ssd1306_pixel(ssd1306_t *ssd, uint8_t x, uint8_t y, bool value);
 void ssd1306_fill(ssd1306_t *ssd, bool value);
+void ssd1306_load_frame(ssd1306_t *ssd, const uint8_t *pixels);
+void ssd1306_fill_rect(ssd1306_t *ssd, int x, int y, int width, int height, bool value);
 void ssd1306_rect(ssd1306_t *ssd, uint8_t top, uint8_t left, uint8_t width, uint8_t height, bool value, bool fill);
 void ssd1306_line(ssd1306_t *ssd, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, bool value);
 void ssd1306_hline(ssd1306_t *ssd, uint8_t x0, uint8_t x1, uint8_t y, bool value);
 void ssd1306_vline(ssd1306_t *ssd, uint8_t x, uint8_t y0, uint8_t y1, bool value);
 
+// Effects run by the controller itself from a few command bytes. Requests matching the
+// current state send nothing; a flush with changes stops the scroll and resends the frame.
+void ssd1306_scroll(ssd1306_t *ssd, const ssd1306_scroll_t *scroll);
+void ssd1306_scroll_stop(ssd1306_t *ssd);
+void ssd1306_contrast(ssd1306_t *ssd, uint8_t level);
+void ssd1306_invert(ssd1306_t *ssd, bool inverted);
+
 // Novas funções para suportar números pequenos
 void ssd1306_draw_small_number(ssd1306_t *ssd, char c, uint8_t x, uint8_t y);
 void ssd1306_draw_char(ssd1306_t *ssd, char c, uint8_t x, uint8_t y, bool use_small_numbers);
 void ssd1306_draw_string(ssd1306_t *ssd, const char *str, uint8_t x, uint8_t y, bool use_small_numbers);
 
+#ifdef __cplusplus
+}
+#endif
+
 #endif // SSD1306_H
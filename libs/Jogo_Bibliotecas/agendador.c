@@ -0,0 +1,98 @@
+#include "agendador.h"
+#include "pico/stdlib.h"
+
+void agendador_iniciar(agendador_t *ag, agendador_relogio_t relogio, uint32_t passo_us, uint32_t periodo_render_us) {
+    ag->relogio = relogio;
+    ag->passo_us = passo_us;
+    ag->periodo_render_us = periodo_render_us;
+    ag->tempo_logico_us = 0;
+    ag->passos = 0;
+    ag->renders = 0;
+    ag->renders_pulados = 0;
+    ag->prazos_perdidos = 0;
+    ag->passos_descartados = 0;
+    ag->jitter_max_us = 0;
+    ag->jitter_soma_us = 0;
+    ag->amostras_jitter = 0;
+    agendador_sincronizar(ag);
+}
+
+// Recomeça os prazos a partir de agora (ex.: ao sair da pausa), sem recuperar o tempo parado
+void agendador_sincronizar(agendador_t *ag) {
+    uint64_t agora = ag->relogio();
+    ag->proximo_passo_us = agora;
+    ag->proximo_render_us = agora;
+    ag->renders_pulados_seguidos = 0;
+    ag->passos_pendentes = 0;
+}
+
+// Retorna quantos passos de lógica venceram desde a última chamada
+uint32_t agendador_atualizar(agendador_t *ag) {
+    uint64_t agora = ag->relogio();
+    if (agora < ag->proximo_passo_us) return ag->passos_pendentes;
+
+    uint64_t atraso = agora - ag->proximo_passo_us;
+    uint32_t jitter = atraso > UINT32_MAX ? UINT32_MAX : (uint32_t)atraso;
+    if (jitter > ag->jitter_max_us) ag->jitter_max_us = jitter;
+    ag->jitter_soma_us += jitter;
+    ag->amostras_jitter++;
+
+    uint64_t vencidos = 1 + atraso / ag->passo_us;
+    ag->prazos_perdidos += (uint32_t)(vencidos - 1);
+
+    uint32_t passos = (uint32_t)vencidos;
+    if (vencidos > AGENDADOR_MAX_PASSOS) {
+        // Sobrecarga prolongada: descarta o atraso em vez de acelerar o jogo
+        ag->passos_descartados += (uint32_t)(vencidos - AGENDADOR_MAX_PASSOS);
+        passos = AGENDADOR_MAX_PASSOS;
+        ag->proximo_passo_us = agora + ag->passo_us;
+    } else {
+        ag->proximo_passo_us += vencidos * ag->passo_us;
+    }
+
+    ag->passos_pendentes = passos;
+    return passos;
+}
+
+// Consome um passo vencido, avançando o tempo lógico visto pela lógica do jogo
+bool agendador_consumir_passo(agendador_t *ag) {
+    if (ag->passos_pendentes == 0) return false;
+    ag->passos_pendentes--;
+    ag->passos++;
+    ag->tempo_logico_us += ag->passo_us;
+    return true;
+}
+
+// Decide se vale desenhar agora; sob sobrecarga o quadro é pulado para a lógica não atrasar
+bool agendador_deve_renderizar(agendador_t *ag) {
+    uint64_t agora = ag->relogio();
+    if (agora < ag->proximo_render_us) return false;
+
+    if (agora >= ag->proximo_passo_us && ag->renders_pulados_seguidos < AGENDADOR_MAX_RENDERS_PULADOS) {
+        ag->renders_pulados++;
+        ag->renders_pulados_seguidos++;
+        return false;
+    }
+
+    ag->proximo_render_us += ag->periodo_render_us;
+    if (ag->proximo_render_us < agora) ag->proximo_render_us = agora;
+    ag->renders_pulados_seguidos = 0;
+    ag->renders++;
+    return true;
+}
+
+// Dorme até o próximo prazo de lógica
+void agendador_dormir(agendador_t *ag) {
+    uint64_t agora = ag->relogio();
+    if (agora < ag->proximo_passo_us) {
+        sleep_us(ag->proximo_passo_us - agora);
+    }
+}
+
+uint32_t agendador_tempo_logico_ms(const agendador_t *ag) {
+    return (uint32_t)(ag->tempo_logico_us / 1000);
+}
+
+uint32_t agendador_jitter_medio_us(const agendador_t *ag) {
+    return ag->amostras_jitter ? (uint32_t)(ag->jitter_soma_us / ag->amostras_jitter) : 0;
+}
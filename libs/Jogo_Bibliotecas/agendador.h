@@ -0,0 +1,43 @@
+#ifndef AGENDADOR_H
+#define AGENDADOR_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define AGENDADOR_MAX_PASSOS 4            // Passos de lógica recuperados por chamada antes de descartar atraso
+#define AGENDADOR_MAX_RENDERS_PULADOS 4   // Força um quadro após tantos renders pulados seguidos
+
+// Fonte de tempo em microssegundos (time_us_64 no dispositivo, relógio falso no host)
+typedef uint64_t (*agendador_relogio_t)(void);
+
+typedef struct {
+    agendador_relogio_t relogio;
+    uint32_t passo_us;            // Período fixo da lógica
+    uint32_t periodo_render_us;   // Período mínimo entre quadros desenhados
+    uint64_t proximo_passo_us;    // Prazo do próximo passo de lógica
+    uint64_t proximo_render_us;
+    uint64_t tempo_logico_us;     // Avança exatamente passo_us por passo executado
+    uint8_t renders_pulados_seguidos;
+    uint8_t passos_pendentes;     // Vencidos em agendador_atualizar e ainda não consumidos
+
+    // Contadores de desempenho
+    uint32_t passos;
+    uint32_t renders;
+    uint32_t renders_pulados;
+    uint32_t prazos_perdidos;     // Passos executados depois do prazo do passo seguinte
+    uint32_t passos_descartados;  // Passos abandonados por excesso de atraso
+    uint32_t jitter_max_us;       // Maior atraso entre o prazo e o início do passo
+    uint64_t jitter_soma_us;
+    uint32_t amostras_jitter;
+} agendador_t;
+
+void agendador_iniciar(agendador_t *ag, agendador_relogio_t relogio, uint32_t passo_us, uint32_t periodo_render_us);
+void agendador_sincronizar(agendador_t *ag);
+uint32_t agendador_atualizar(agendador_t *ag);
+bool agendador_consumir_passo(agendador_t *ag);
+bool agendador_deve_renderizar(agendador_t *ag);
+void agendador_dormir(agendador_t *ag);
+uint32_t agendador_tempo_logico_ms(const agendador_t *ag);
+uint32_t agendador_jitter_medio_us(const agendador_t *ag);
+
+#endif // AGENDADOR_H
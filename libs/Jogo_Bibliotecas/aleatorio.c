@@ -0,0 +1,21 @@
+#include "aleatorio.h"
+
+#define SEMENTE_PADRAO 0x9E3779B9u   // xorshift nunca sai do zero
+
+static uint32_t estado = SEMENTE_PADRAO;
+
+void aleatorio_semear(uint32_t semente) {
+    estado = semente ? semente : SEMENTE_PADRAO;
+}
+
+uint32_t aleatorio_proximo(void) {
+    estado ^= estado << 13;
+    estado ^= estado >> 17;
+    estado ^= estado << 5;
+    return estado;
+}
+
+// Multiplica e fica com a parte alta: sem divisão nem laço de rejeição, viés < limite / 2^32
+uint32_t aleatorio_intervalo(uint32_t limite) {
+    return (uint32_t)(((uint64_t)aleatorio_proximo() * limite) >> 32);
+}
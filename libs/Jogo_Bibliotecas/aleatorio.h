@@ -0,0 +1,11 @@
+#ifndef ALEATORIO_H
+#define ALEATORIO_H
+
+#include <stdint.h>
+
+// xorshift32: mesma sequência no dispositivo e no host, ao contrário de rand()
+void aleatorio_semear(uint32_t semente);
+uint32_t aleatorio_proximo(void);
+uint32_t aleatorio_intervalo(uint32_t limite);   // Em [0, limite)
+
+#endif // ALEATORIO_H
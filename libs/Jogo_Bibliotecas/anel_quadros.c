@@ -0,0 +1,47 @@
+#include "anel_quadros.h"
+
+void anel_quadros_iniciar(anel_quadros_t *anel) {
+    __atomic_store_n(&anel->produzidos, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&anel->consumidos, 0, __ATOMIC_RELAXED);
+    anel->descartados = 0;
+    anel->pulados = 0;
+}
+
+// Produtor: slot livre para montar o próximo quadro, ou NULL se o consumidor está atrasado
+quadro_t *anel_quadros_reservar(anel_quadros_t *anel) {
+    uint32_t produzidos = __atomic_load_n(&anel->produzidos, __ATOMIC_RELAXED);
+    uint32_t consumidos = __atomic_load_n(&anel->consumidos, __ATOMIC_ACQUIRE);
+    if (produzidos - consumidos >= ANEL_QUADROS_CAPACIDADE) {
+        anel->descartados++;
+        return NULL;
+    }
+    return &anel->slots[produzidos & (ANEL_QUADROS_CAPACIDADE - 1)];
+}
+
+// Produtor: torna visível o slot reservado; retorna o número de sequência do quadro
+uint32_t anel_quadros_publicar(anel_quadros_t *anel) {
+    uint32_t produzidos = __atomic_load_n(&anel->produzidos, __ATOMIC_RELAXED) + 1;
+    __atomic_store_n(&anel->produzidos, produzidos, __ATOMIC_RELEASE);
+    return produzidos;
+}
+
+// Consumidor: quadro mais novo publicado, ou NULL se não há nada novo.
+// Quadros mais antigos na fila são liberados sem serem apresentados.
+quadro_t *anel_quadros_proximo(anel_quadros_t *anel) {
+    uint32_t produzidos = __atomic_load_n(&anel->produzidos, __ATOMIC_ACQUIRE);
+    uint32_t consumidos = __atomic_load_n(&anel->consumidos, __ATOMIC_RELAXED);
+    if (produzidos == consumidos) return NULL;
+
+    if (produzidos - consumidos > 1) {
+        anel->pulados += produzidos - consumidos - 1;
+        consumidos = produzidos - 1;
+        __atomic_store_n(&anel->consumidos, consumidos, __ATOMIC_RELEASE);
+    }
+    return &anel->slots[consumidos & (ANEL_QUADROS_CAPACIDADE - 1)];
+}
+
+// Consumidor: devolve o slot obtido em anel_quadros_proximo
+void anel_quadros_liberar(anel_quadros_t *anel) {
+    uint32_t consumidos = __atomic_load_n(&anel->consumidos, __ATOMIC_RELAXED);
+    __atomic_store_n(&anel->consumidos, consumidos + 1, __ATOMIC_RELEASE);
+}
@@ -0,0 +1,47 @@
+#ifndef ANEL_QUADROS_H
+#define ANEL_QUADROS_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ANEL_QUADROS_CAPACIDADE 4          // Potência de 2: um em uso pelo consumidor, o resto na fila
+#define ANEL_QUADRO_BYTES (128 * 64 / 8)   // Páginas do SSD1306, sem o byte de controle
+
+// Um quadro pronto: imagem do OLED, efeitos do controlador e o número mostrado na matriz LED.
+// Tudo que o núcleo 1 mostra vem daqui, nada de globais do núcleo 0.
+typedef struct {
+    uint8_t tela[ANEL_QUADRO_BYTES];
+    int8_t vidas;                          // Negativo desliga a matriz
+    bool pausado;                          // A matriz mostra as vidas na cor da pausa
+    uint8_t contraste;                     // Efeitos aplicados por comando depois da imagem
+    bool invertida;
+    bool letreiro;
+} quadro_t;
+
+// Anel sem trava de um produtor (núcleo 0) e um consumidor (núcleo 1).
+// Só o produtor escreve 'produzidos' e só o consumidor escreve 'consumidos';
+// os contadores são acessados com __atomic para valer em C, C++ e entre núcleos.
+typedef struct {
+    quadro_t slots[ANEL_QUADROS_CAPACIDADE];
+    uint32_t produzidos;
+    uint32_t consumidos;
+    uint32_t descartados;                  // Produtor: anel cheio, quadro não publicado
+    uint32_t pulados;                      // Consumidor: quadros antigos substituídos por um mais novo
+} anel_quadros_t;
+
+void anel_quadros_iniciar(anel_quadros_t *anel);
+quadro_t *anel_quadros_reservar(anel_quadros_t *anel);
+uint32_t anel_quadros_publicar(anel_quadros_t *anel);
+quadro_t *anel_quadros_proximo(anel_quadros_t *anel);
+void anel_quadros_liberar(anel_quadros_t *anel);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ANEL_QUADROS_H
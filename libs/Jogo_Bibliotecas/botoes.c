@@ -0,0 +1,51 @@
+#include "botoes.h"
+#include <string.h>
+
+void botoes_iniciar(botoes_t *b, const uint8_t *pinos, uint8_t quantidade, uint32_t agora_us) {
+    memset(b, 0, sizeof(*b));
+    if (quantidade > BOTOES_MAX) quantidade = BOTOES_MAX;
+    memcpy(b->pinos, pinos, quantidade);
+    b->quantidade = quantidade;
+    // Um aperto logo após o boot já conta
+    for (uint8_t i = 0; i < quantidade; i++) b->ultima_borda_us[i] = agora_us - BOTOES_QUIETO_US;
+}
+
+// Produtor, chamado da IRQ com as bordas que ela travou e o nível do pino (baixo = apertado).
+// O ressalto pode travar descida e subida juntas antes do atendimento, e o nível lido agora
+// pode estar no meio dele; por isso o aperto é a descida que sai de um pino quieto e solto,
+// e solto é o nível lido na IRQ anterior, que a janela quieta garante ser o assentado.
+void botoes_borda(botoes_t *b, unsigned int pino, uint32_t eventos, bool baixo, uint32_t agora_us) {
+    uint8_t i = 0;
+    while (i < b->quantidade && b->pinos[i] != pino) i++;
+    if (i == b->quantidade) return;
+
+    b->bordas++;
+    uint32_t quieto_us = agora_us - b->ultima_borda_us[i];
+    bool estava_solto = !b->baixo[i];
+    b->ultima_borda_us[i] = agora_us;
+    b->baixo[i] = baixo;
+    if (!(eventos & BOTOES_DESCIDA)) return;
+    if (quieto_us < BOTOES_QUIETO_US) {
+        b->ressaltos++;
+        return;
+    }
+    if (!estava_solto) return;   // Descida no ressalto de uma soltura que a IRQ travou junto
+
+    uint32_t produzidos = __atomic_load_n(&b->produzidos, __ATOMIC_RELAXED);
+    uint32_t consumidos = __atomic_load_n(&b->consumidos, __ATOMIC_ACQUIRE);
+    if (produzidos - consumidos == BOTOES_FILA) {
+        b->descartados++;
+        return;
+    }
+    b->fila[produzidos & (BOTOES_FILA - 1)] = (evento_botao_t){ agora_us, i };
+    __atomic_store_n(&b->produzidos, produzidos + 1, __ATOMIC_RELEASE);
+}
+
+// Consumidor: tira o aperto mais antigo; false com a fila vazia
+bool botoes_proximo(botoes_t *b, evento_botao_t *evento) {
+    uint32_t consumidos = __atomic_load_n(&b->consumidos, __ATOMIC_RELAXED);
+    if (__atomic_load_n(&b->produzidos, __ATOMIC_ACQUIRE) == consumidos) return false;
+    *evento = b->fila[consumidos & (BOTOES_FILA - 1)];
+    __atomic_store_n(&b->consumidos, consumidos + 1, __ATOMIC_RELEASE);
+    return true;
+}
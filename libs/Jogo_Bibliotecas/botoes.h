@@ -0,0 +1,49 @@
+#ifndef BOTOES_H
+#define BOTOES_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define BOTOES_MAX   4
+#define BOTOES_FILA  16    // Potência de 2
+
+// Bordas travadas pela IRQ, nos mesmos bits de GPIO_IRQ_EDGE_FALL e GPIO_IRQ_EDGE_RISE
+#define BOTOES_DESCIDA 0x4u
+#define BOTOES_SUBIDA  0x8u
+
+// Uma descida só vale como aperto se o pino ficou sem bordas por esta janela antes dela:
+// o primeiro contato passa na hora e o ressalto que vem logo depois (ou na soltura) não.
+#ifndef BOTOES_QUIETO_US
+#define BOTOES_QUIETO_US 20000
+#endif
+
+typedef struct {
+    uint32_t tempo_us;     // time_us_32 da borda aceita
+    uint8_t botao;         // Índice em botoes_iniciar
+} evento_botao_t;
+
+// Fila sem trava de um produtor (a IRQ de GPIO) e um consumidor (o laço principal),
+// com os contadores em __atomic como em anel_quadros. Só a IRQ mexe no resto do estado.
+typedef struct {
+    uint8_t pinos[BOTOES_MAX];
+    uint8_t quantidade;
+    uint32_t ultima_borda_us[BOTOES_MAX];
+    bool baixo[BOTOES_MAX];   // Nível lido na última IRQ: o assentado, se o pino ficou quieto desde então
+    evento_botao_t fila[BOTOES_FILA];
+    uint32_t produzidos;
+    uint32_t consumidos;
+    uint32_t bordas;       // Todas as bordas vistas
+    uint32_t ressaltos;    // Descidas recusadas pela janela
+    uint32_t descartados;  // Apertos perdidos com a fila cheia
+} botoes_t;
+
+void botoes_iniciar(botoes_t *b, const uint8_t *pinos, uint8_t quantidade, uint32_t agora_us);
+void botoes_borda(botoes_t *b, unsigned int pino, uint32_t eventos, bool baixo, uint32_t agora_us);
+bool botoes_proximo(botoes_t *b, evento_botao_t *evento);
+
+// Vale da IRQ e do laço principal, sem consumir nada
+static inline bool botoes_pendentes(const botoes_t *b) {
+    return __atomic_load_n(&b->produzidos, __ATOMIC_ACQUIRE) != __atomic_load_n(&b->consumidos, __ATOMIC_RELAXED);
+}
+
+#endif // BOTOES_H
@@ -0,0 +1,127 @@
+#include "entidades.h"
+#include <string.h>
+
+void entidades_iniciar(entidades_t *e) {
+    e->quantidade = 0;
+    e->num_livres = ENTIDADES_CAPACIDADE;
+    for (uint16_t i = 0; i < ENTIDADES_CAPACIDADE; i++) e->livres[i] = ENTIDADES_CAPACIDADE - 1 - i;
+}
+
+entidade_id_t entidades_criar(entidades_t *e, tipo_entidade_t tipo, int x, int y, int largura, int altura) {
+    if (e->num_livres == 0) return ENTIDADE_NENHUMA;
+    entidade_id_t id = e->livres[--e->num_livres];
+    uint16_t i = e->quantidade++;
+    e->x[i] = (int16_t)x;
+    e->y[i] = (int16_t)y;
+    e->vx[i] = 0;
+    e->vy[i] = 0;
+    e->largura[i] = (uint8_t)largura;
+    e->altura[i] = (uint8_t)altura;
+    e->tipo[i] = (uint8_t)tipo;
+    e->id[i] = id;
+    e->indice[id] = i;
+    return id;
+}
+
+void entidades_remover(entidades_t *e, entidade_id_t id) {
+    uint16_t i = e->indice[id];
+    uint16_t ultima = --e->quantidade;
+    if (i != ultima) {
+        e->x[i] = e->x[ultima];
+        e->y[i] = e->y[ultima];
+        e->vx[i] = e->vx[ultima];
+        e->vy[i] = e->vy[ultima];
+        e->largura[i] = e->largura[ultima];
+        e->altura[i] = e->altura[ultima];
+        e->tipo[i] = e->tipo[ultima];
+        e->id[i] = e->id[ultima];
+        e->indice[e->id[i]] = i;
+    }
+    e->livres[e->num_livres++] = id;
+}
+
+void entidades_mover(entidades_t *e) {
+    for (uint16_t i = 0; i < e->quantidade; i++) {
+        e->x[i] += e->vx[i];
+        e->y[i] += e->vy[i];
+    }
+}
+
+static int coluna(int x) {
+    int c = x >> GRADE_CELULA_BITS;
+    return c < 0 ? 0 : (c >= GRADE_COLUNAS ? GRADE_COLUNAS - 1 : c);
+}
+
+static int linha(int y) {
+    int l = y >> GRADE_CELULA_BITS;
+    return l < 0 ? 0 : (l >= GRADE_LINHAS ? GRADE_LINHAS - 1 : l);
+}
+
+void grade_montar(grade_t *g, const entidades_t *e) {
+    uint16_t contagem[GRADE_CELULAS];
+    uint8_t *celula = g->celula;
+    memset(contagem, 0, sizeof(contagem));
+    g->largura_max = 0;
+    g->altura_max = 0;
+    for (uint16_t i = 0; i < e->quantidade; i++) {
+        celula[i] = (uint8_t)(linha(e->y[i]) * GRADE_COLUNAS + coluna(e->x[i]));
+        contagem[celula[i]]++;
+        if (e->largura[i] > g->largura_max) g->largura_max = e->largura[i];
+        if (e->altura[i] > g->altura_max) g->altura_max = e->altura[i];
+    }
+    uint16_t soma = 0;
+    for (int c = 0; c < GRADE_CELULAS; c++) {
+        g->inicio[c] = soma;
+        soma += contagem[c];
+        contagem[c] = g->inicio[c];
+    }
+    g->inicio[GRADE_CELULAS] = soma;
+    for (uint16_t i = 0; i < e->quantidade; i++) g->ordem[contagem[celula[i]]++] = i;
+}
+
+static bool sobrepoe(const entidades_t *e, uint16_t i, int x, int y, int largura, int altura) {
+    return e->x[i] < x + largura && e->x[i] + e->largura[i] > x && e->y[i] < y + altura && e->y[i] + e->altura[i] > y;
+}
+
+// Ids das entidades que sobrepõem o retângulo; devolve quantas achou (no máximo max)
+uint16_t grade_consultar(const grade_t *g, const entidades_t *e, int x, int y, int largura, int altura,
+                         entidade_id_t *saida, uint16_t max) {
+    uint16_t achadas = 0;
+    int c0 = coluna(x - g->largura_max + 1), c1 = coluna(x + largura - 1);
+    int l0 = linha(y - g->altura_max + 1), l1 = linha(y + altura - 1);
+    for (int l = l0; l <= l1; l++) {
+        for (int c = c0; c <= c1; c++) {
+            int celula = l * GRADE_COLUNAS + c;
+            for (uint16_t k = g->inicio[celula]; k < g->inicio[celula + 1]; k++) {
+                uint16_t i = g->ordem[k];
+                if (!sobrepoe(e, i, x, y, largura, altura)) continue;
+                if (achadas == max) return achadas;
+                saida[achadas++] = e->id[i];
+            }
+        }
+    }
+    return achadas;
+}
+
+// Chama par() uma vez para cada par de entidades sobrepostas; devolve quantos pares houve
+uint32_t grade_pares(const grade_t *g, const entidades_t *e, grade_par_t par, void *contexto) {
+    uint32_t pares = 0;
+    for (uint16_t a = 0; a < e->quantidade; a++) {
+        int x = e->x[a], y = e->y[a], largura = e->largura[a], altura = e->altura[a];
+        int c0 = coluna(x - g->largura_max + 1), c1 = coluna(x + largura - 1);
+        int l0 = linha(y - g->altura_max + 1), l1 = linha(y + altura - 1);
+        for (int l = l0; l <= l1; l++) {
+            for (int c = c0; c <= c1; c++) {
+                int celula = l * GRADE_COLUNAS + c;
+                for (uint16_t k = g->inicio[celula]; k < g->inicio[celula + 1]; k++) {
+                    uint16_t b = g->ordem[k];
+                    // Cada par sai só do lado do menor índice denso
+                    if (b <= a || !sobrepoe(e, b, x, y, largura, altura)) continue;
+                    pares++;
+                    if (par) par(e->id[a], e->id[b], contexto);
+                }
+            }
+        }
+    }
+    return pares;
+}
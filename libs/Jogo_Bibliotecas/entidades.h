@@ -0,0 +1,67 @@
+#ifndef ENTIDADES_H
+#define ENTIDADES_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// O jogo cria o jogador e um coletável; cada entidade custa 15 bytes aqui e 3 na grade.
+// Quem precisa de mais (bench_entidades vai a 512) define a capacidade na compilação.
+#ifndef ENTIDADES_CAPACIDADE
+#define ENTIDADES_CAPACIDADE 16
+#endif
+#define ENTIDADE_NENHUMA 0xFFFF
+
+// Grade uniforme sobre a tela: 16 x 8 células de 8 px. Fora da tela vale a célula da borda.
+#define GRADE_CELULA_BITS 3
+#define GRADE_COLUNAS     16
+#define GRADE_LINHAS      8
+#define GRADE_CELULAS     (GRADE_COLUNAS * GRADE_LINHAS)
+
+typedef enum {
+    ENTIDADE_JOGADOR,
+    ENTIDADE_COLETAVEL,
+    ENTIDADE_PERIGO,
+} tipo_entidade_t;
+
+typedef uint16_t entidade_id_t;
+
+// Estrutura de arrays sem heap: as entidades vivas ocupam [0, quantidade) de cada array,
+// e remover move a última para o buraco. O id não muda com isso; entidades_indice o traduz.
+typedef struct {
+    int16_t x[ENTIDADES_CAPACIDADE], y[ENTIDADES_CAPACIDADE];
+    int8_t vx[ENTIDADES_CAPACIDADE], vy[ENTIDADES_CAPACIDADE];
+    uint8_t largura[ENTIDADES_CAPACIDADE], altura[ENTIDADES_CAPACIDADE];
+    uint8_t tipo[ENTIDADES_CAPACIDADE];
+    entidade_id_t id[ENTIDADES_CAPACIDADE];        // Índice denso -> id
+    uint16_t indice[ENTIDADES_CAPACIDADE];         // Id -> índice denso
+    entidade_id_t livres[ENTIDADES_CAPACIDADE];    // Pilha de ids sem dono
+    uint16_t num_livres;
+    uint16_t quantidade;
+} entidades_t;
+
+// Cada entidade entra só na célula do seu canto superior esquerdo (ordenação por contagem);
+// as consultas alargam a busca pelo maior tamanho visto, então nada é inserido duas vezes.
+typedef struct {
+    uint16_t inicio[GRADE_CELULAS + 1];
+    uint16_t ordem[ENTIDADES_CAPACIDADE];          // Índices densos agrupados por célula
+    uint8_t celula[ENTIDADES_CAPACIDADE];          // Rascunho da montagem, fora da pilha
+    uint8_t largura_max, altura_max;
+} grade_t;
+
+typedef void (*grade_par_t)(entidade_id_t a, entidade_id_t b, void *contexto);
+
+void entidades_iniciar(entidades_t *e);
+entidade_id_t entidades_criar(entidades_t *e, tipo_entidade_t tipo, int x, int y, int largura, int altura);
+void entidades_remover(entidades_t *e, entidade_id_t id);
+void entidades_mover(entidades_t *e);
+
+static inline uint16_t entidades_indice(const entidades_t *e, entidade_id_t id) {
+    return e->indice[id];
+}
+
+void grade_montar(grade_t *g, const entidades_t *e);
+uint16_t grade_consultar(const grade_t *g, const entidades_t *e, int x, int y, int largura, int altura,
+                         entidade_id_t *saida, uint16_t max);
+uint32_t grade_pares(const grade_t *g, const entidades_t *e, grade_par_t par, void *contexto);
+
+#endif // ENTIDADES_H
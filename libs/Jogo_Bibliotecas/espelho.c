@@ -0,0 +1,96 @@
+#include "espelho.h"
+#include <string.h>
+
+#define RLE_LITERAIS_MAX  128
+#define RLE_REPETICAO_MIN 3
+#define RLE_REPETICAO_MAX (0x7F + RLE_REPETICAO_MIN)
+#define RLE_PIOR_PAGINA   (ESPELHO_LARGURA + ESPELHO_LARGURA / RLE_LITERAIS_MAX)
+
+_Static_assert(ESPELHO_ORCAMENTO_BYTES >= 3 + RLE_PIOR_PAGINA, "o orçamento precisa caber uma página inteira");
+
+void espelho_iniciar(espelho_t *e) {
+    memset(e, 0, sizeof(*e));
+}
+
+// Codifica uma página (em XOR com base, ou inteira sem base); 0 se não couber em espaco
+static size_t rle_pagina(const uint8_t *pagina, const uint8_t *base, uint8_t *saida, size_t espaco) {
+    uint8_t bytes[ESPELHO_LARGURA];
+    for (int i = 0; i < ESPELHO_LARGURA; i++) bytes[i] = base ? pagina[i] ^ base[i] : pagina[i];
+
+    size_t n = 0;
+    int i = 0, literais = 0;
+    while (i < ESPELHO_LARGURA) {
+        int repeticao = 1;
+        while (i + repeticao < ESPELHO_LARGURA && repeticao < RLE_REPETICAO_MAX && bytes[i + repeticao] == bytes[i]) {
+            repeticao++;
+        }
+        if (repeticao >= RLE_REPETICAO_MIN || literais == RLE_LITERAIS_MAX) {
+            if (literais) {
+                if (n + 1 + literais > espaco) return 0;
+                saida[n++] = (uint8_t)(literais - 1);
+                memcpy(&saida[n], &bytes[i - literais], literais);
+                n += literais;
+                literais = 0;
+            }
+            if (repeticao >= RLE_REPETICAO_MIN) {
+                if (n + 2 > espaco) return 0;
+                saida[n++] = (uint8_t)(0x80 + repeticao - RLE_REPETICAO_MIN);
+                saida[n++] = bytes[i];
+                i += repeticao;
+                continue;
+            }
+        }
+        literais++;
+        i++;
+    }
+    if (literais) {
+        if (n + 1 + literais > espaco) return 0;
+        saida[n++] = (uint8_t)(literais - 1);
+        memcpy(&saida[n], &bytes[ESPELHO_LARGURA - literais], literais);
+        n += literais;
+    }
+    return n;
+}
+
+// Codifica o quadro contra 'visto' dentro do orçamento e o publica; se o anel não tiver
+// espaço o quadro é descartado sem esperar, e 'visto' não muda
+bool espelho_publicar(espelho_t *e, const uint8_t *tela, telemetria_t *t) {
+    uint8_t paginas = 0, chaves = 0;
+    uint8_t proxima = e->primeira;
+    bool adiou = false;
+    size_t n = 3;
+    for (int k = 0; k < ESPELHO_PAGINAS; k++) {
+        int p = (e->primeira + k) % ESPELHO_PAGINAS;
+        const uint8_t *pagina = &tela[p * ESPELHO_LARGURA], *visto = &e->visto[p * ESPELHO_LARGURA];
+        bool inteira = p == e->chave;
+        if (!inteira && memcmp(pagina, visto, ESPELHO_LARGURA) == 0) continue;
+
+        size_t tamanho = rle_pagina(pagina, inteira ? NULL : visto, &e->carga[n], sizeof(e->carga) - n);
+        if (tamanho == 0) {
+            // Sem espaço: o próximo quadro começa aqui, para esta página não ficar sempre de fora
+            if (!adiou) proxima = (uint8_t)p;
+            adiou = true;
+            continue;
+        }
+        n += tamanho;
+        paginas |= 1u << p;
+        if (inteira) chaves |= 1u << p;
+    }
+    e->carga[0] = e->primeira;
+    e->carga[1] = paginas;
+    e->carga[2] = chaves;
+
+    if (!telemetria_enviar(t, TELEMETRIA_TIPO_TELA, e->carga, n)) {
+        e->descartados++;
+        return false;
+    }
+    for (int p = 0; p < ESPELHO_PAGINAS; p++) {
+        if (paginas & (1u << p)) memcpy(&e->visto[p * ESPELHO_LARGURA], &tela[p * ESPELHO_LARGURA], ESPELHO_LARGURA);
+    }
+    if (chaves) e->chave = (uint8_t)((e->chave + 1) % ESPELHO_PAGINAS);
+    e->primeira = proxima;
+    e->quadros++;
+    e->adiados += adiou;
+    e->bytes += n;
+    return true;
+}
@@ -0,0 +1,40 @@
+#ifndef ESPELHO_H
+#define ESPELHO_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "telemetria.h"
+
+// Espelho do OLED pela telemetria (registros TELEMETRIA_TIPO_TELA). Carga:
+//   primeira:u8 paginas:u8 chaves:u8, e para cada página com bit em 'paginas', a partir de
+//   'primeira' e dando a volta, 128 bytes em RLE: cabeçalho < 0x80 traz cabeçalho+1 literais,
+//   >= 0x80 repete o byte seguinte (cabeçalho - 0x80 + 3) vezes.
+// Página com bit em 'chaves' vem inteira; as outras vêm em XOR com o que o visualizador já tem.
+// Uma página por quadro vai inteira, em rodízio, então quem conecta no meio (ou perdeu um
+// registro) se acerta em 8 quadros. Página sem mudança e fora do rodízio não vai.
+#define ESPELHO_PAGINAS 8
+#define ESPELHO_LARGURA 128
+#define ESPELHO_BYTES   (ESPELHO_PAGINAS * ESPELHO_LARGURA)
+
+// Carga máxima de um quadro: o que não couber fica para o próximo, que começa pela página
+// que faltou. Cabe sempre o cabeçalho e uma página no pior caso (129 bytes).
+#ifndef ESPELHO_ORCAMENTO_BYTES
+#define ESPELHO_ORCAMENTO_BYTES 256
+#endif
+
+typedef struct {
+    uint8_t visto[ESPELHO_BYTES];     // O que o visualizador tem, se recebeu tudo que entrou no anel
+    uint8_t carga[ESPELHO_ORCAMENTO_BYTES];
+    uint8_t primeira;                 // Página por onde o próximo quadro começa
+    uint8_t chave;                    // Página que vai inteira no próximo quadro
+    uint32_t quadros;                 // Publicados
+    uint32_t descartados;             // Sem espaço no anel: o próximo sai contra o mesmo 'visto'
+    uint32_t adiados;                 // Quadros em que alguma página mudada ficou de fora
+    uint64_t bytes;                   // Carga publicada
+} espelho_t;
+
+void espelho_iniciar(espelho_t *e);
+bool espelho_publicar(espelho_t *e, const uint8_t *tela, telemetria_t *t);
+
+#endif // ESPELHO_H
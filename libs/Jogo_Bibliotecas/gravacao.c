@@ -0,0 +1,124 @@
+#include "gravacao.h"
+#include <string.h>
+
+#define FNV_BASE 2166136261u
+#define FNV_PRIMO 16777619u
+
+static void escrever_u16(uint8_t *p, uint16_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static void escrever_u32(uint8_t *p, uint32_t v) {
+    escrever_u16(p, (uint16_t)v);
+    escrever_u16(p + 2, (uint16_t)(v >> 16));
+}
+
+static uint16_t ler_u16(const uint8_t *p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t ler_u32(const uint8_t *p) {
+    return ler_u16(p) | ((uint32_t)ler_u16(p + 2) << 16);
+}
+
+void gravacao_iniciar(gravacao_t *g, gravacao_saida_t saida, const gravacao_cabecalho_t *cabecalho) {
+    uint8_t bytes[GRAVACAO_CABECALHO_BYTES];
+    memcpy(bytes, GRAVACAO_MAGICA, 4);
+    escrever_u32(&bytes[4], cabecalho->semente);
+    escrever_u32(&bytes[8], cabecalho->passo_us);
+    escrever_u16(&bytes[12], cabecalho->centro_x);
+    escrever_u16(&bytes[14], cabecalho->centro_y);
+
+    g->saida = saida;
+    g->botoes = 0;
+    g->passos = 0;
+    g->ativa = true;
+    saida(bytes, sizeof(bytes));
+}
+
+// Chamado do laço principal para cada aperto tirado da fila de botões
+void gravacao_botao(gravacao_t *g, uint8_t botao) {
+    g->botoes |= botao;
+}
+
+void gravacao_passo(gravacao_t *g, uint16_t x, uint16_t y) {
+    if (!g->ativa) return;
+    uint8_t botoes = g->botoes;
+    g->botoes = 0;
+
+    uint8_t bytes[4] = {
+        (uint8_t)(botoes & (GRAVACAO_QUADRO - 1)),
+        (uint8_t)x,
+        (uint8_t)(((x >> 8) & 0x0F) | (y << 4)),
+        (uint8_t)(y >> 4),
+    };
+    g->passos++;
+    g->saida(bytes, sizeof(bytes));
+}
+
+void gravacao_quadro(gravacao_t *g, uint32_t hash) {
+    if (!g->ativa) return;
+    uint8_t bytes[5] = { GRAVACAO_QUADRO };
+    escrever_u32(&bytes[1], hash);
+    g->saida(bytes, sizeof(bytes));
+}
+
+void gravacao_encerrar(gravacao_t *g, int pontuacao, int vidas) {
+    if (!g->ativa) return;
+    uint8_t bytes[8] = { GRAVACAO_FIM };
+    escrever_u16(&bytes[1], (uint16_t)pontuacao);
+    bytes[3] = (uint8_t)vidas;
+    escrever_u32(&bytes[4], g->passos);
+    g->ativa = false;
+    g->saida(bytes, sizeof(bytes));
+}
+
+uint32_t gravacao_hash(const uint8_t *dados, size_t n) {
+    uint32_t hash = FNV_BASE;
+    for (size_t i = 0; i < n; i++) {
+        hash = (hash ^ dados[i]) * FNV_PRIMO;
+    }
+    return hash;
+}
+
+bool reproducao_abrir(reproducao_t *r, const uint8_t *dados, size_t tamanho) {
+    if (tamanho < GRAVACAO_CABECALHO_BYTES || memcmp(dados, GRAVACAO_MAGICA, 4) != 0) return false;
+    r->dados = dados;
+    r->tamanho = tamanho;
+    r->posicao = GRAVACAO_CABECALHO_BYTES;
+    r->cabecalho.semente = ler_u32(&dados[4]);
+    r->cabecalho.passo_us = ler_u32(&dados[8]);
+    r->cabecalho.centro_x = ler_u16(&dados[12]);
+    r->cabecalho.centro_y = ler_u16(&dados[14]);
+    return true;
+}
+
+reproducao_tipo_t reproducao_proximo(reproducao_t *r, reproducao_registro_t *registro) {
+    size_t restante = r->tamanho - r->posicao;
+    const uint8_t *p = &r->dados[r->posicao];
+    registro->tipo = REPRODUCAO_ERRO;
+    if (restante == 0) return REPRODUCAO_ERRO;
+
+    if (p[0] == GRAVACAO_FIM) {
+        if (restante < 8) return REPRODUCAO_ERRO;
+        registro->pontuacao = ler_u16(&p[1]);
+        registro->vidas = (int8_t)p[3];
+        registro->passos = ler_u32(&p[4]);
+        registro->tipo = REPRODUCAO_FIM;
+        r->posicao += 8;
+    } else if (p[0] == GRAVACAO_QUADRO) {
+        if (restante < 5) return REPRODUCAO_ERRO;
+        registro->hash = ler_u32(&p[1]);
+        registro->tipo = REPRODUCAO_QUADRO;
+        r->posicao += 5;
+    } else if (p[0] < GRAVACAO_QUADRO) {
+        if (restante < 4) return REPRODUCAO_ERRO;
+        registro->botoes = p[0];
+        registro->x = (uint16_t)(p[1] | ((p[2] & 0x0F) << 8));
+        registro->y = (uint16_t)((p[2] >> 4) | (p[3] << 4));
+        registro->tipo = REPRODUCAO_PASSO;
+        r->posicao += 4;
+    }
+    return registro->tipo;
+}
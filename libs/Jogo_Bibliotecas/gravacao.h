@@ -0,0 +1,72 @@
+#ifndef GRAVACAO_H
+#define GRAVACAO_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// Formato (little-endian):
+//   cabeçalho  "BRG1" semente:u32 passo_us:u32 centro_x:u16 centro_y:u16
+//   passo      botoes:u8 (< 0x40) x|y:3 bytes (12 bits cada)
+//   quadro     0x40 hash:u32      (FNV-1a do framebuffer desenhado após o último passo)
+//   fim        0x80 pontuacao:u16 vidas:u8 passos:u32
+#define GRAVACAO_MAGICA "BRG1"
+#define GRAVACAO_CABECALHO_BYTES 16
+
+#define GRAVACAO_BOTAO_B         0x01
+#define GRAVACAO_BOTAO_A         0x02
+#define GRAVACAO_BOTAO_JOYSTICK  0x04
+#define GRAVACAO_QUADRO          0x40
+#define GRAVACAO_FIM             0x80
+
+// Recebe cada registro pronto; no dispositivo vai para o stdio
+typedef void (*gravacao_saida_t)(const uint8_t *bytes, size_t n);
+
+typedef struct {
+    uint32_t semente;
+    uint32_t passo_us;
+    uint16_t centro_x, centro_y;
+} gravacao_cabecalho_t;
+
+typedef struct {
+    gravacao_saida_t saida;
+    uint8_t botoes;              // Apertos atendidos desde o último passo
+    uint32_t passos;
+    bool ativa;
+} gravacao_t;
+
+typedef enum {
+    REPRODUCAO_PASSO,
+    REPRODUCAO_QUADRO,
+    REPRODUCAO_FIM,
+    REPRODUCAO_ERRO,
+} reproducao_tipo_t;
+
+typedef struct {
+    reproducao_tipo_t tipo;
+    uint8_t botoes;
+    uint16_t x, y;
+    uint32_t hash;
+    int pontuacao;
+    int vidas;
+    uint32_t passos;
+} reproducao_registro_t;
+
+typedef struct {
+    const uint8_t *dados;
+    size_t tamanho;
+    size_t posicao;
+    gravacao_cabecalho_t cabecalho;
+} reproducao_t;
+
+void gravacao_iniciar(gravacao_t *g, gravacao_saida_t saida, const gravacao_cabecalho_t *cabecalho);
+void gravacao_botao(gravacao_t *g, uint8_t botao);
+void gravacao_passo(gravacao_t *g, uint16_t x, uint16_t y);
+void gravacao_quadro(gravacao_t *g, uint32_t hash);
+void gravacao_encerrar(gravacao_t *g, int pontuacao, int vidas);
+uint32_t gravacao_hash(const uint8_t *dados, size_t n);
+
+bool reproducao_abrir(reproducao_t *r, const uint8_t *dados, size_t tamanho);
+reproducao_tipo_t reproducao_proximo(reproducao_t *r, reproducao_registro_t *registro);
+
+#endif // GRAVACAO_H
@@ -0,0 +1,139 @@
+#include "perfil.h"
+
+#if PERFILAR_QUADROS
+#include <stdio.h>
+#include <string.h>
+#include "pico/stdlib.h"
+
+#define CALIBRAGEM_PARES 256
+
+typedef struct {
+    perfil_etapa_t etapa;
+    uint32_t inicio_us;
+    uint32_t filhos_us;      // Tempo das etapas aninhadas, descontado desta
+} perfil_aberta_t;
+
+static const char *const nomes[PERFIL_NUM_ETAPAS] = {
+    "entrada", "logica", "desenho", "envio_display", "matriz", "som", "telemetria",
+    "tela_inicial", "tela_pausa", "tela_game_over", "ocioso",
+};
+
+static perfil_estatistica_t estatisticas[PERFIL_NUM_ETAPAS];
+static perfil_aberta_t pilha[PERFIL_PROFUNDIDADE];
+static uint8_t topo;
+static uint8_t transbordos;  // Aberturas além da profundidade: ignoradas, fechamento incluído
+static uint32_t inicio_janela_us;
+
+static uint32_t balde(uint32_t us) {
+    if (us < PERFIL_BALDES_LINEARES) return us;
+    uint32_t expoente = 31 - __builtin_clz(us);
+    uint32_t sub = (us >> (expoente - PERFIL_SUBBALDES_BITS)) & ((1 << PERFIL_SUBBALDES_BITS) - 1);
+    uint32_t indice = PERFIL_BALDES_LINEARES + ((expoente - 4) << PERFIL_SUBBALDES_BITS) + sub;
+    return indice < PERFIL_BALDES ? indice : PERFIL_BALDES - 1;
+}
+
+// Maior valor que cai no balde
+static uint32_t teto_balde(uint32_t indice) {
+    if (indice < PERFIL_BALDES_LINEARES) return indice;
+    uint32_t expoente = 4 + ((indice - PERFIL_BALDES_LINEARES) >> PERFIL_SUBBALDES_BITS);
+    uint32_t sub = (indice - PERFIL_BALDES_LINEARES) & ((1 << PERFIL_SUBBALDES_BITS) - 1);
+    return (((1u << PERFIL_SUBBALDES_BITS) + sub + 1) << (expoente - PERFIL_SUBBALDES_BITS)) - 1;
+}
+
+static void registrar(perfil_estatistica_t *e, uint32_t us) {
+    if (e->amostras == 0 || us < e->minimo_us) e->minimo_us = us;
+    if (us > e->maximo_us) e->maximo_us = us;
+    e->amostras++;
+    e->soma_us += us;
+    e->baldes[balde(us)]++;
+}
+
+void perfil_zerar(void) {
+    memset(estatisticas, 0, sizeof(estatisticas));
+    inicio_janela_us = time_us_32();
+}
+
+void perfil_iniciar(perfil_etapa_t etapa) {
+    if (topo == PERFIL_PROFUNDIDADE) {
+        transbordos++;
+        return;
+    }
+    pilha[topo].etapa = etapa;
+    pilha[topo].filhos_us = 0;
+    pilha[topo].inicio_us = time_us_32();
+    topo++;
+}
+
+void perfil_encerrar(void) {
+    uint32_t agora = time_us_32();
+    if (transbordos) {
+        transbordos--;
+        return;
+    }
+    if (topo == 0) return;
+    perfil_aberta_t *aberta = &pilha[--topo];
+    uint32_t total = agora - aberta->inicio_us;
+    registrar(&estatisticas[aberta->etapa], total - aberta->filhos_us);
+    if (topo) pilha[topo - 1].filhos_us += total;
+}
+
+const perfil_estatistica_t *perfil_estatistica(perfil_etapa_t etapa) {
+    return &estatisticas[etapa];
+}
+
+uint32_t perfil_percentil_us(perfil_etapa_t etapa, uint32_t por_mil) {
+    const perfil_estatistica_t *e = &estatisticas[etapa];
+    if (e->amostras == 0) return 0;
+    uint64_t alvo = ((uint64_t)e->amostras * por_mil + 999) / 1000;
+    uint64_t acumulado = 0;
+    for (uint32_t i = 0; i < PERFIL_BALDES; i++) {
+        acumulado += e->baldes[i];
+        if (acumulado >= alvo) {
+            uint32_t teto = teto_balde(i);
+            return teto < e->maximo_us ? teto : e->maximo_us;
+        }
+    }
+    return e->maximo_us;
+}
+
+// Custo de um par início/fim medido com uma estatística descartável, em ns
+static uint32_t custo_par_ns(void) {
+    static perfil_estatistica_t rascunho;
+    uint32_t inicio = time_us_32();
+    for (int i = 0; i < CALIBRAGEM_PARES; i++) {
+        uint32_t t0 = time_us_32();
+        registrar(&rascunho, time_us_32() - t0);
+    }
+    return (time_us_32() - inicio) * 1000 / CALIBRAGEM_PARES;
+}
+
+void perfil_imprimir(void) {
+    uint32_t janela_us = time_us_32() - inicio_janela_us;
+    uint64_t medido_us = 0;
+    uint32_t pares = 0;
+
+    printf("Perfil de %lu ms (us exclusivos por ocorrência):\n", (unsigned long)(janela_us / 1000));
+    printf("%-15s %8s %7s %8s %7s %7s %6s\n", "etapa", "n", "min", "media", "p99", "max", "%");
+    for (int i = 0; i < PERFIL_NUM_ETAPAS; i++) {
+        const perfil_estatistica_t *e = &estatisticas[i];
+        medido_us += e->soma_us;
+        pares += e->amostras;
+        if (e->amostras == 0) continue;
+        printf("%-15s %8lu %7lu %8.1f %7lu %7lu %6.2f\n", nomes[i], (unsigned long)e->amostras,
+               (unsigned long)e->minimo_us, (double)e->soma_us / e->amostras,
+               (unsigned long)perfil_percentil_us(i, 990), (unsigned long)e->maximo_us,
+               janela_us ? 100.0 * e->soma_us / janela_us : 0.0);
+    }
+    uint32_t custo_ns = custo_par_ns();
+    printf("Coberto: %.1f%% da janela; custo do perfil: %lu ns por etapa, %.3f%% da janela\n",
+           janela_us ? 100.0 * medido_us / janela_us : 0.0, (unsigned long)custo_ns,
+           janela_us ? (double)pares * custo_ns / 10.0 / janela_us : 0.0);
+}
+
+// 'p' imprime o perfil, 'z' zera; chamado dos laços principais, não bloqueia
+void perfil_atender_serial(void) {
+    int c = getchar_timeout_us(0);
+    if (c == 'p') perfil_imprimir();
+    else if (c == 'z') perfil_zerar();
+}
+#endif
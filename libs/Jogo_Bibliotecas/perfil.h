@@ -0,0 +1,60 @@
+#ifndef PERFIL_H
+#define PERFIL_H
+
+#include <stdint.h>
+
+// 1: mede cada etapa dos laços do jogo; 0: as macros somem e nada do perfil é compilado
+#ifndef PERFILAR_QUADROS
+#define PERFILAR_QUADROS 0
+#endif
+
+typedef enum {
+    PERFIL_ENTRADA,          // Leitura do joystick
+    PERFIL_LOGICA,           // Movimento e colisões de um passo
+    PERFIL_DESENHO,          // Raster do quadro de jogo no framebuffer
+    PERFIL_ENVIO_DISPLAY,    // Início do envio I2C (ou publicação para o núcleo 1)
+    PERFIL_MATRIZ,           // Atualização da matriz LED
+    PERFIL_SOM,              // Enfileiramento das notas dos buzzers
+    PERFIL_TELEMETRIA,       // Registro binário de cada quadro e escrita no USB
+    PERFIL_TELA_INICIAL,
+    PERFIL_TELA_PAUSA,
+    PERFIL_TELA_GAME_OVER,
+    PERFIL_OCIOSO,           // Dormindo até o próximo prazo
+    PERFIL_NUM_ETAPAS,
+} perfil_etapa_t;
+
+// Histograma log-linear em us: exato abaixo de 16 us, depois 4 baldes por potência de 2
+// (erro de até 25% no p99), até ~16 s
+#define PERFIL_BALDES_LINEARES 16
+#define PERFIL_SUBBALDES_BITS  2
+#define PERFIL_BALDES          (PERFIL_BALDES_LINEARES + 20 * (1 << PERFIL_SUBBALDES_BITS))
+#define PERFIL_PROFUNDIDADE    4   // Etapas aninhadas ao mesmo tempo
+
+typedef struct {
+    uint32_t amostras;
+    uint32_t minimo_us, maximo_us;
+    uint64_t soma_us;
+    uint32_t baldes[PERFIL_BALDES];
+} perfil_estatistica_t;
+
+#if PERFILAR_QUADROS
+// Tempos são exclusivos: uma etapa aninhada (envio dentro do desenho, som dentro da lógica)
+// desconta o seu tempo da etapa que a contém, e a soma das etapas fecha com o tempo total.
+#define PERFIL_INICIO(etapa) perfil_iniciar(etapa)
+#define PERFIL_FIM()         perfil_encerrar()
+#define PERFIL_ATENDER()     perfil_atender_serial()
+
+void perfil_zerar(void);
+void perfil_iniciar(perfil_etapa_t etapa);
+void perfil_encerrar(void);
+const perfil_estatistica_t *perfil_estatistica(perfil_etapa_t etapa);
+uint32_t perfil_percentil_us(perfil_etapa_t etapa, uint32_t por_mil);
+void perfil_imprimir(void);
+void perfil_atender_serial(void);
+#else
+#define PERFIL_INICIO(etapa) ((void)0)
+#define PERFIL_FIM()         ((void)0)
+#define PERFIL_ATENDER()     ((void)0)
+#endif
+
+#endif // PERFIL_H
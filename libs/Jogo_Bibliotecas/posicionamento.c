@@ -0,0 +1,132 @@
+#include "posicionamento.h"
+#include <string.h>
+#include "aleatorio.h"
+
+typedef struct {
+    int16_t inicio, fim;           // [inicio, fim)
+} intervalo_t;
+
+void posicionamento_iniciar(posicionamento_t *p, const retangulo_t *area, int16_t largura_item, int16_t altura_item) {
+    memset(p, 0, sizeof(*p));
+    p->area = *area;
+    p->largura_item = largura_item;
+    p->altura_item = altura_item;
+    p->desatualizado = true;
+}
+
+void posicionamento_excluir(posicionamento_t *p, uint8_t indice, const retangulo_t *exclusao) {
+    uint8_t bit = 1u << indice;
+    if ((p->exclusoes_ativas & bit) && !memcmp(&p->exclusoes[indice], exclusao, sizeof(*exclusao))) return;
+    p->exclusoes[indice] = *exclusao;
+    p->exclusoes_ativas |= bit;
+    p->desatualizado = true;
+}
+
+void posicionamento_liberar(posicionamento_t *p, uint8_t indice) {
+    uint8_t bit = 1u << indice;
+    if (!(p->exclusoes_ativas & bit)) return;
+    p->exclusoes_ativas &= ~bit;
+    p->desatualizado = true;
+}
+
+static int16_t limitar(int v, int minimo, int maximo) {
+    return (int16_t)(v < minimo ? minimo : (v > maximo ? maximo : v));
+}
+
+static void ordenar(int16_t *v, int n) {
+    for (int i = 1; i < n; i++) {
+        int16_t atual = v[i];
+        int j = i;
+        for (; j > 0 && v[j - 1] > atual; j--) v[j] = v[j - 1];
+        v[j] = atual;
+    }
+}
+
+static void ordenar_intervalos(intervalo_t *v, int n) {
+    for (int i = 1; i < n; i++) {
+        intervalo_t atual = v[i];
+        int j = i;
+        for (; j > 0 && v[j - 1].inicio > atual.inicio; j--) v[j] = v[j - 1];
+        v[j] = atual;
+    }
+}
+
+// Divide as posições candidatas em faixas horizontais onde o conjunto de exclusões não muda
+// e, em cada faixa, guarda os trechos em x que sobram entre as exclusões
+static void montar_livres(posicionamento_t *p) {
+    int x0 = p->area.x, x1 = p->area.x + p->area.largura - p->largura_item + 1;
+    int y0 = p->area.y, y1 = p->area.y + p->area.altura - p->altura_item + 1;
+    p->num_livres = 0;
+    p->desatualizado = false;
+    if (x1 <= x0 || y1 <= y0) return;
+
+    // Posições em que o item tocaria cada exclusão, cortadas à área candidata
+    retangulo_t bloqueios[POSICIONAMENTO_MAX_EXCLUSOES];
+    int num_bloqueios = 0;
+    int16_t divisas[2 * POSICIONAMENTO_MAX_EXCLUSOES + 2];
+    int num_divisas = 0;
+    divisas[num_divisas++] = (int16_t)y0;
+    divisas[num_divisas++] = (int16_t)y1;
+    for (int i = 0; i < POSICIONAMENTO_MAX_EXCLUSOES; i++) {
+        if (!(p->exclusoes_ativas & (1u << i))) continue;
+        const retangulo_t *e = &p->exclusoes[i];
+        int16_t bx0 = limitar(e->x - p->largura_item + 1, x0, x1), bx1 = limitar(e->x + e->largura, x0, x1);
+        int16_t by0 = limitar(e->y - p->altura_item + 1, y0, y1), by1 = limitar(e->y + e->altura, y0, y1);
+        if (bx0 >= bx1 || by0 >= by1) continue;
+        bloqueios[num_bloqueios++] = (retangulo_t){ bx0, by0, (int16_t)(bx1 - bx0), (int16_t)(by1 - by0) };
+        divisas[num_divisas++] = by0;
+        divisas[num_divisas++] = by1;
+    }
+    ordenar(divisas, num_divisas);
+
+    uint32_t acumulado = 0;
+    for (int d = 0; d + 1 < num_divisas; d++) {
+        int16_t topo = divisas[d], base = divisas[d + 1];
+        if (topo == base) continue;
+
+        intervalo_t cobertos[POSICIONAMENTO_MAX_EXCLUSOES];
+        int num_cobertos = 0;
+        for (int b = 0; b < num_bloqueios; b++) {
+            const retangulo_t *r = &bloqueios[b];
+            if (r->y <= topo && r->y + r->altura >= base) {
+                cobertos[num_cobertos++] = (intervalo_t){ r->x, (int16_t)(r->x + r->largura) };
+            }
+        }
+        ordenar_intervalos(cobertos, num_cobertos);
+
+        int16_t x = (int16_t)x0;
+        for (int c = 0; c <= num_cobertos; c++) {
+            int16_t fim = c < num_cobertos ? cobertos[c].inicio : (int16_t)x1;
+            if (fim > x) {
+                p->livres[p->num_livres] = (retangulo_t){ x, topo, (int16_t)(fim - x), (int16_t)(base - topo) };
+                acumulado += (uint32_t)(fim - x) * (uint32_t)(base - topo);
+                p->acumulado[p->num_livres++] = acumulado;
+            }
+            if (c < num_cobertos && cobertos[c].fim > x) x = cobertos[c].fim;
+        }
+    }
+}
+
+uint32_t posicionamento_livres(posicionamento_t *p) {
+    if (p->desatualizado) montar_livres(p);
+    return p->num_livres ? p->acumulado[p->num_livres - 1] : 0;
+}
+
+// Uniforme entre todas as posições livres; false (e x, y intactos) se não sobra nenhuma
+bool posicionamento_sortear(posicionamento_t *p, int *x, int *y) {
+    uint32_t total = posicionamento_livres(p);
+    if (total == 0) return false;
+    uint32_t sorteio = aleatorio_intervalo(total);
+
+    uint16_t baixo = 0, alto = p->num_livres - 1;
+    while (baixo < alto) {
+        uint16_t meio = (uint16_t)((baixo + alto) / 2);
+        if (p->acumulado[meio] > sorteio) alto = meio;
+        else baixo = meio + 1;
+    }
+    const retangulo_t *livre = &p->livres[baixo];
+    uint32_t deslocamento = sorteio - (baixo ? p->acumulado[baixo - 1] : 0);
+    *x = livre->x + (int)(deslocamento % (uint32_t)livre->largura);
+    *y = livre->y + (int)(deslocamento / (uint32_t)livre->largura);
+    return true;
+}
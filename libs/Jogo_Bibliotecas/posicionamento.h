@@ -0,0 +1,37 @@
+#ifndef POSICIONAMENTO_H
+#define POSICIONAMENTO_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define POSICIONAMENTO_MAX_EXCLUSOES 8
+// Cada exclusão abre no máximo duas divisas horizontais e parte uma faixa em mais um trecho
+#define POSICIONAMENTO_MAX_FAIXAS    (2 * POSICIONAMENTO_MAX_EXCLUSOES + 1)
+#define POSICIONAMENTO_MAX_LIVRES    (POSICIONAMENTO_MAX_FAIXAS * (POSICIONAMENTO_MAX_EXCLUSOES + 1))
+
+typedef struct {
+    int16_t x, y, largura, altura;
+} retangulo_t;
+
+// Sorteia onde um item cabe inteiro na área sem sobrepor nenhuma exclusão (HUD, jogador,
+// obstáculos). As posições livres do canto superior esquerdo ficam numa lista de retângulos
+// disjuntos, refeita só quando as exclusões mudam; o sorteio é uma busca binária nessa lista,
+// com custo limitado não importa quanto do campo esteja ocupado.
+typedef struct {
+    retangulo_t area;
+    int16_t largura_item, altura_item;
+    retangulo_t exclusoes[POSICIONAMENTO_MAX_EXCLUSOES];
+    uint8_t exclusoes_ativas;      // Um bit por índice de exclusão
+    bool desatualizado;            // Exclusões mudaram desde a última montagem dos livres
+    retangulo_t livres[POSICIONAMENTO_MAX_LIVRES];
+    uint32_t acumulado[POSICIONAMENTO_MAX_LIVRES];  // Posições livres até este retângulo, inclusive
+    uint16_t num_livres;
+} posicionamento_t;
+
+void posicionamento_iniciar(posicionamento_t *p, const retangulo_t *area, int16_t largura_item, int16_t altura_item);
+void posicionamento_excluir(posicionamento_t *p, uint8_t indice, const retangulo_t *exclusao);
+void posicionamento_liberar(posicionamento_t *p, uint8_t indice);
+uint32_t posicionamento_livres(posicionamento_t *p);
+bool posicionamento_sortear(posicionamento_t *p, int *x, int *y);
+
+#endif // POSICIONAMENTO_H
@@ -0,0 +1,118 @@
+#include "telemetria.h"
+
+static uint8_t *escrever_u16(uint8_t *p, uint16_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    return p + 2;
+}
+
+static uint8_t *escrever_u32(uint8_t *p, uint32_t v) {
+    return escrever_u16(escrever_u16(p, (uint16_t)v), (uint16_t)(v >> 16));
+}
+
+void telemetria_iniciar(telemetria_t *t) {
+    __atomic_store_n(&t->produzidos, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&t->consumidos, 0, __ATOMIC_RELAXED);
+    t->sequencia = 0;
+    t->descartados = 0;
+}
+
+// COBS escrito direto no anel: cada 0x00 vira a distância até o próximo, e o byte de código
+// de cada bloco é preenchido quando o bloco fecha. Nada é visível ao consumidor até o fim.
+typedef struct {
+    telemetria_t *t;
+    uint32_t escrita;              // Posição absoluta no anel
+    uint32_t codigo_pos;
+    uint8_t codigo;
+    uint8_t soma;
+} enquadrador_t;
+
+static void anel_por(telemetria_t *t, uint32_t pos, uint8_t b) {
+    t->dados[pos & (TELEMETRIA_ANEL_BYTES - 1)] = b;
+}
+
+static void cobs_byte(enquadrador_t *e, uint8_t b) {
+    e->soma += b;
+    if (b != 0) {
+        anel_por(e->t, e->escrita++, b);
+        e->codigo++;
+    }
+    if (b == 0 || e->codigo == 0xFF) {
+        anel_por(e->t, e->codigo_pos, e->codigo);
+        e->codigo_pos = e->escrita++;
+        e->codigo = 1;
+    }
+}
+
+static void cobs_bytes(enquadrador_t *e, const uint8_t *bytes, size_t n) {
+    for (size_t i = 0; i < n; i++) cobs_byte(e, bytes[i]);
+}
+
+// Produtor: enquadra um registro de qualquer tipo no anel; false se não há espaço para o pior caso
+bool telemetria_enviar(telemetria_t *t, uint8_t tipo, const uint8_t *carga, size_t n) {
+    size_t registro = 1 + 4 + n + 1;
+    size_t pior_caso = 1 + registro + registro / 254 + 1 + 1;
+    uint32_t produzidos = __atomic_load_n(&t->produzidos, __ATOMIC_RELAXED);
+    uint32_t consumidos = __atomic_load_n(&t->consumidos, __ATOMIC_ACQUIRE);
+    if (TELEMETRIA_ANEL_BYTES - (produzidos - consumidos) < pior_caso) {
+        t->descartados++;
+        t->sequencia++;
+        return false;
+    }
+
+    anel_por(t, produzidos, 0);
+    enquadrador_t e = { t, produzidos + 2, produzidos + 1, 1, 0 };
+    uint8_t cabecalho[5];
+    cabecalho[0] = tipo;
+    escrever_u32(&cabecalho[1], t->sequencia++);
+    cobs_bytes(&e, cabecalho, sizeof(cabecalho));
+    cobs_bytes(&e, carga, n);
+    cobs_byte(&e, (uint8_t)-e.soma);
+    anel_por(t, e.codigo_pos, e.codigo);
+    anel_por(t, e.escrita++, 0);
+    __atomic_store_n(&t->produzidos, e.escrita, __ATOMIC_RELEASE);
+    return true;
+}
+
+// Serializa o estado do quadro e enfileira; false se o anel não tem espaço
+bool telemetria_publicar(telemetria_t *t, const telemetria_quadro_t *q) {
+    uint8_t carga[TELEMETRIA_CARGA_BYTES];
+    uint8_t *p = carga;
+    p = escrever_u32(p, q->tempo_ms);
+    p = escrever_u32(p, q->passos);
+    p = escrever_u32(p, q->renders);
+    p = escrever_u32(p, q->matriz_enviadas);
+    p = escrever_u32(p, q->matriz_puladas);
+    p = escrever_u16(p, q->joystick_x);
+    p = escrever_u16(p, q->joystick_y);
+    p = escrever_u16(p, q->pontuacao);
+    p = escrever_u16(p, q->renders_pulados);
+    p = escrever_u16(p, q->prazos_perdidos);
+    p = escrever_u16(p, q->jitter_medio_us);
+    p = escrever_u16(p, q->jitter_max_us);
+    *p++ = q->jogador_x;
+    *p++ = q->jogador_y;
+    *p++ = q->pixel_x;
+    *p++ = q->pixel_y;
+    *p++ = q->vidas;
+    *p++ = q->estado;
+    return telemetria_enviar(t, TELEMETRIA_TIPO_QUADRO, carga, sizeof(carga));
+}
+
+// Consumidor: entrega à saída o que ela aceitar, em no máximo dois trechos contíguos
+size_t telemetria_drenar(telemetria_t *t, telemetria_saida_t saida) {
+    size_t total = 0;
+    for (int trecho = 0; trecho < 2; trecho++) {
+        uint32_t produzidos = __atomic_load_n(&t->produzidos, __ATOMIC_ACQUIRE);
+        uint32_t consumidos = __atomic_load_n(&t->consumidos, __ATOMIC_RELAXED);
+        uint32_t inicio = consumidos & (TELEMETRIA_ANEL_BYTES - 1);
+        size_t n = produzidos - consumidos;
+        if (n > TELEMETRIA_ANEL_BYTES - inicio) n = TELEMETRIA_ANEL_BYTES - inicio;
+        if (n == 0) break;
+        size_t aceitos = saida(&t->dados[inicio], n);
+        __atomic_store_n(&t->consumidos, consumidos + (uint32_t)aceitos, __ATOMIC_RELEASE);
+        total += aceitos;
+        if (aceitos < n) break;
+    }
+    return total;
+}
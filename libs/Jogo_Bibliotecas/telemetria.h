@@ -0,0 +1,60 @@
+#ifndef TELEMETRIA_H
+#define TELEMETRIA_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+// Quadro no fio: 0x00 COBS(tipo:u8 sequencia:u32 carga soma:u8) 0x00
+// Todos os campos little-endian; a soma faz todos os bytes do registro somarem 0 (mod 256).
+// O 0x00 antes e depois deixa o decodificador se ressincronizar com texto do printf no meio.
+// A sequência é uma só para todos os tipos, então um salto aponta registro perdido de qualquer um.
+// tools/telemetria_csv.py decodifica os quadros (layout da carga em telemetria.c) e
+// tools/espelho_tela.py as telas (layout em espelho.h).
+#define TELEMETRIA_TIPO_QUADRO   1
+#define TELEMETRIA_TIPO_TELA     2
+#define TELEMETRIA_CARGA_BYTES   40     // Do registro de quadro
+#define TELEMETRIA_ANEL_BYTES    1024   // Potência de 2: ~20 registros de quadro esperando o USB
+
+#define TELEMETRIA_ESTADO_INICIADO  0x01
+#define TELEMETRIA_ESTADO_PAUSADO   0x02
+#define TELEMETRIA_ESTADO_FIM       0x04
+#define TELEMETRIA_ESTADO_IMUNE     0x08
+
+typedef struct {
+    uint32_t tempo_ms;
+    uint32_t passos;
+    uint32_t renders;
+    uint32_t matriz_enviadas;
+    uint32_t matriz_puladas;
+    uint16_t joystick_x, joystick_y;
+    uint16_t pontuacao;
+    uint16_t renders_pulados;      // Saturados em 0xFFFF
+    uint16_t prazos_perdidos;
+    uint16_t jitter_medio_us;
+    uint16_t jitter_max_us;
+    uint8_t jogador_x, jogador_y;
+    uint8_t pixel_x, pixel_y;
+    uint8_t vidas;
+    uint8_t estado;                // TELEMETRIA_ESTADO_*
+} telemetria_quadro_t;
+
+// Aceita até n bytes sem bloquear e devolve quantos levou
+typedef size_t (*telemetria_saida_t)(const uint8_t *bytes, size_t n);
+
+// Anel de bytes sem trava, um produtor (laço do jogo) e um consumidor (quem drena).
+// Registros entram inteiros ou não entram: anel cheio descarta e a sequência pula.
+typedef struct {
+    uint8_t dados[TELEMETRIA_ANEL_BYTES];
+    uint32_t produzidos;           // Bytes; só o produtor escreve
+    uint32_t consumidos;           // Bytes; só o consumidor escreve
+    uint32_t sequencia;
+    uint32_t descartados;          // Registros que não couberam
+} telemetria_t;
+
+void telemetria_iniciar(telemetria_t *t);
+bool telemetria_publicar(telemetria_t *t, const telemetria_quadro_t *quadro);
+bool telemetria_enviar(telemetria_t *t, uint8_t tipo, const uint8_t *carga, size_t n);
+size_t telemetria_drenar(telemetria_t *t, telemetria_saida_t saida);
+
+#endif // TELEMETRIA_H
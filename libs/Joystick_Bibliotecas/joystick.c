@@ -0,0 +1,77 @@
+#include "joystick.h"
+#include "hardware/adc.h"
+#include "hardware/dma.h"
+
+#define PRIMEIRO_PINO_ADC 26
+#define CLOCK_ADC_HZ 48000000
+#define TRANSFERENCIAS 0xFFFFFFFEu  // Par, para o anel recomeçar sempre no mesmo eixo
+
+// O DMA escreve em anel; o alinhamento ao tamanho em bytes é exigido pelo modo ring
+static volatile uint16_t amostras[JOYSTICK_AMOSTRAS] __attribute__((aligned(JOYSTICK_AMOSTRAS * sizeof(uint16_t))));
+static int canal_dma = -1;
+static uint canal_adc_x, canal_adc_y;
+static uint paridade_x;   // Posição de X no par intercalado (o round robin começa no menor canal)
+
+static uint log2_tamanho_anel() {
+    uint bits = 0;
+    while ((1u << bits) < JOYSTICK_AMOSTRAS * sizeof(uint16_t)) bits++;
+    return bits;
+}
+
+// (Re)inicia o round robin e o DMA juntos para a amostra 0 do anel ser sempre do menor canal
+static void iniciar_amostragem() {
+    adc_run(false);
+    while (!(adc_hw->cs & ADC_CS_READY_BITS)) tight_loop_contents();
+    adc_fifo_drain();
+    adc_select_input(canal_adc_x < canal_adc_y ? canal_adc_x : canal_adc_y);
+    dma_channel_transfer_to_buffer_now(canal_dma, amostras, TRANSFERENCIAS);
+    adc_run(true);
+}
+
+void joystick_iniciar(uint pino_x, uint pino_y) {
+    adc_init();
+    adc_gpio_init(pino_x);
+    adc_gpio_init(pino_y);
+    canal_adc_x = pino_x - PRIMEIRO_PINO_ADC;
+    canal_adc_y = pino_y - PRIMEIRO_PINO_ADC;
+    paridade_x = canal_adc_x < canal_adc_y ? 0 : 1;
+
+    int canal = dma_claim_unused_channel(false);
+    if (canal < 0) return; // Sem DMA: joystick_ler converte sob demanda
+    canal_dma = canal;
+
+    // Round robin entre os dois eixos, cada conversão vai para a FIFO e pede DMA
+    adc_set_round_robin((1u << canal_adc_x) | (1u << canal_adc_y));
+    adc_fifo_setup(true, true, 1, false, false);
+    adc_set_clkdiv((float)CLOCK_ADC_HZ / JOYSTICK_TAXA_HZ - 1);
+
+    dma_channel_config cfg = dma_channel_get_default_config(canal);
+    channel_config_set_transfer_data_size(&cfg, DMA_SIZE_16);
+    channel_config_set_read_increment(&cfg, false);
+    channel_config_set_write_increment(&cfg, true);
+    channel_config_set_ring(&cfg, true, log2_tamanho_anel());
+    channel_config_set_dreq(&cfg, DREQ_ADC);
+    dma_channel_configure(canal, &cfg, amostras, &adc_hw->fifo, TRANSFERENCIAS, false);
+    iniciar_amostragem();
+}
+
+// Média das JOYSTICK_MEDIA amostras de cada eixo no anel, em escala de 12 bits.
+// Lê o anel enquanto o DMA escreve: cada amostra é uma escrita atômica de 16 bits,
+// então a média mistura no máximo amostras novas e antigas, sem travar nada.
+void joystick_ler(uint16_t *x, uint16_t *y) {
+    if (canal_dma < 0) {
+        adc_select_input(canal_adc_x);
+        *x = adc_read();
+        adc_select_input(canal_adc_y);
+        *y = adc_read();
+        return;
+    }
+    if (!dma_channel_is_busy(canal_dma)) iniciar_amostragem();
+
+    uint32_t soma[2] = { 0, 0 };
+    for (uint i = 0; i < JOYSTICK_AMOSTRAS; i++) {
+        soma[i & 1] += amostras[i];
+    }
+    *x = (uint16_t)(soma[paridade_x] / JOYSTICK_MEDIA);
+    *y = (uint16_t)(soma[paridade_x ^ 1] / JOYSTICK_MEDIA);
+}
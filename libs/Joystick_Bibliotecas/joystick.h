@@ -0,0 +1,13 @@
+#ifndef JOYSTICK_H
+#define JOYSTICK_H
+
+#include "pico/stdlib.h"
+
+#define JOYSTICK_TAXA_HZ 4000           // Conversões por segundo, somando os dois eixos
+#define JOYSTICK_AMOSTRAS 64            // Anel do DMA (potência de 2), X e Y intercalados
+#define JOYSTICK_MEDIA (JOYSTICK_AMOSTRAS / 2)  // Amostras por eixo somadas em cada leitura
+
+void joystick_iniciar(uint pino_x, uint pino_y);
+void joystick_ler(uint16_t *x, uint16_t *y);
+
+#endif // JOYSTICK_H
@@ -1,60 +1,103 @@
 #include "matriz_led.h"
+#include <string.h>
+#include "hardware/dma.h"
+#include "assets/vidas.h"
 
-// Definições dos padrões de números (5x5)
-const bool numero_0[NUM_PIXELS] = {
-    0,1,1,1,0,
-    1,0,0,0,1,
-    1,0,0,0,1,
-    1,0,0,0,1,
-    0,1,1,1,0
-};
-
-const bool numero_1[NUM_PIXELS] = {
-    1, 1, 1, 1, 1,
-    0, 0, 1, 0, 0,
-    0, 0, 1, 0, 0,
-    0, 1, 1, 0, 0,
-    0, 0, 1, 0, 0
-};
-
-const bool numero_2[NUM_PIXELS] = {
-    1, 1, 1, 1, 1,
-    1, 0, 0, 0, 0,
-    1, 1, 1, 1, 1,
-    0, 0, 0, 0, 1,
-    1, 1, 1, 1, 1
-};
-
-const bool numero_3[NUM_PIXELS] = {
-    1, 1, 1, 1, 1,
-    0, 0, 0, 0, 1,
-    1, 1, 1, 1, 1,
-    0, 0, 0, 0, 1,
-    1, 1, 1, 1, 1
-};
+#define MATRIZ_PIO pio0
+#define MATRIZ_SM 0
+#define TEMPO_BIT_NS 1250      // 800 kHz
+#define TEMPO_RESET_US 300     // Linha em nível baixo para o WS2812 travar o quadro
+
+// Quadro desejado (GRB), último quadro enviado e cópia lida pelo DMA
+static uint32_t quadro[NUM_PIXELS];
+static uint32_t quadro_enviado[NUM_PIXELS];
+static uint32_t buffer_dma[NUM_PIXELS];
+static bool enviado_valido = false;
+static int canal_dma = -1;
+static uint64_t livre_em_us = 0;   // Quando a última transmissão termina, incluindo o reset
+static uint32_t atualizacoes_enviadas = 0;
+static uint32_t atualizacoes_puladas = 0;
+
+_Static_assert(NUM_PIXELS <= 32, "um padrão da matriz cabe num uint32_t");
 
 static inline uint32_t rgb_para_uint32(uint8_t r, uint8_t g, uint8_t b) {
     return ((uint32_t)g << 16) | ((uint32_t)r << 8) | b;
 }
 
 void inicializar_matriz_led() {
-    PIO pio = pio0;
+    PIO pio = MATRIZ_PIO;
     uint offset = pio_add_program(pio, &ws2812_program);
-    ws2812_program_init(pio, 0, offset, PINO_WS2812, 800000, RGBW_ATIVO);
+    ws2812_program_init(pio, MATRIZ_SM, offset, PINO_WS2812, 800000, RGBW_ATIVO);
+
+    // DMA alimenta a FIFO do PIO no ritmo do DREQ, sem bloquear a CPU por pixel
+    int canal = dma_claim_unused_channel(false);
+    if (canal >= 0) {
+        dma_channel_config cfg = dma_channel_get_default_config(canal);
+        channel_config_set_transfer_data_size(&cfg, DMA_SIZE_32);
+        channel_config_set_read_increment(&cfg, true);
+        channel_config_set_write_increment(&cfg, false);
+        channel_config_set_dreq(&cfg, pio_get_dreq(pio, MATRIZ_SM, true));
+        dma_channel_configure(canal, &cfg, &pio->txf[MATRIZ_SM], buffer_dma, NUM_PIXELS, false);
+        canal_dma = canal;
+    }
+}
+
+// Espera o quadro anterior sair da FIFO e o tempo de reset do WS2812
+static void esperar_matriz_livre() {
+    if (canal_dma >= 0) dma_channel_wait_for_finish_blocking(canal_dma);
+    while (time_us_64() < livre_em_us) tight_loop_contents();
 }
 
 void enviar_pixel(uint32_t pixel_grb) {
-    pio_sm_put_blocking(pio0, 0, pixel_grb << 8u);
+    // Escrita direta fora do quadro em cache: o próximo quadro é reenviado inteiro
+    esperar_matriz_livre();
+    enviado_valido = false;
+    pio_sm_put_blocking(MATRIZ_PIO, MATRIZ_SM, pixel_grb << 8u);
 }
 
-void mostrar_numero_vidas(int vidas) {
-    // Vamos usar um parâmetro externo para indicar se o jogo está pausado
-    extern volatile bool jogo_pausado;
-    
+void matriz_definir_pixel(int indice, uint32_t pixel_grb) {
+    if (indice >= 0 && indice < NUM_PIXELS) quadro[indice] = pixel_grb;
+}
+
+// Envia o quadro somente se ele mudou desde o último envio
+void matriz_atualizar() {
+    if (enviado_valido && memcmp(quadro, quadro_enviado, sizeof(quadro)) == 0) {
+        atualizacoes_puladas++;
+        return;
+    }
+
+    esperar_matriz_livre();
+    memcpy(quadro_enviado, quadro, sizeof(quadro));
+    enviado_valido = true;
+    for (int i = 0; i < NUM_PIXELS; i++) {
+        buffer_dma[i] = quadro[i] << 8u;
+    }
+
+    if (canal_dma >= 0) {
+        dma_channel_transfer_from_buffer_now(canal_dma, buffer_dma, NUM_PIXELS);
+    } else {
+        for (int i = 0; i < NUM_PIXELS; i++) {
+            pio_sm_put_blocking(MATRIZ_PIO, MATRIZ_SM, buffer_dma[i]);
+        }
+    }
+    livre_em_us = time_us_64() + (NUM_PIXELS * 24 * TEMPO_BIT_NS) / 1000 + TEMPO_RESET_US;
+    atualizacoes_enviadas++;
+}
+
+uint32_t matriz_atualizacoes_enviadas() {
+    return atualizacoes_enviadas;
+}
+
+uint32_t matriz_atualizacoes_puladas() {
+    return atualizacoes_puladas;
+}
+
+// pausado vem de quem chama: com RENDER_NUCLEO1 o núcleo 1 usa o estado gravado no quadro
+void mostrar_numero_vidas(int vidas, bool pausado) {
     uint32_t cor;
     
     // Define a cor com base no estado do jogo e no número de vidas
-    if (jogo_pausado) {
+    if (pausado) {
         // Se o jogo estiver pausado, número fica azul
         cor = rgb_para_uint32(0, 0, 50); // Azul
     } else if (vidas == 0) {
@@ -65,25 +108,17 @@ void mostrar_numero_vidas(int vidas) {
         cor = rgb_para_uint32(0, 50, 0); // Verde
     }
     
-    const bool* padrao;
-     
-    // Seleciona o padrão baseado no número de vidas
-    switch(vidas) {
-        case 3: padrao = numero_3; break;
-        case 2: padrao = numero_2; break;
-        case 1: padrao = numero_1; break;
-        case 0: 
-        default: padrao = numero_0; break;
-    }
-     
-    // Exibe o número na matriz LED
+    // Padrão de assets/matriz/vidas.pbm, um bit por LED; fora de 0 a 3 mostra o 0
+    uint32_t padrao = matriz_vidas[(vidas >= 0 && vidas < MATRIZ_VIDAS_QUADROS) ? vidas : 0];
+
+    // Monta o número no quadro e envia se algo mudou
     for (int i = 0; i < NUM_PIXELS; i++) {
-        enviar_pixel(padrao[i] ? cor : 0);
+        quadro[i] = ((padrao >> i) & 1) ? cor : 0;
     }
+    matriz_atualizar();
 }
 
 void desligar_matriz() {
-    for (int i = 0; i < NUM_PIXELS; i++) {
-        enviar_pixel(0);
-    }
-}
\ No newline at end of file
+    memset(quadro, 0, sizeof(quadro));
+    matriz_atualizar();
+}
@@ -9,15 +9,13 @@
 #define NUM_PIXELS 25
 #define RGBW_ATIVO false
 
-// Números para exibir vidas (0-3)
-extern const bool numero_0[NUM_PIXELS];
-extern const bool numero_1[NUM_PIXELS];
-extern const bool numero_2[NUM_PIXELS];
-extern const bool numero_3[NUM_PIXELS];
-
 void inicializar_matriz_led();
 void enviar_pixel(uint32_t pixel_grb);
-void mostrar_numero_vidas(int vidas);
+void matriz_definir_pixel(int indice, uint32_t pixel_grb);
+void matriz_atualizar();
+uint32_t matriz_atualizacoes_enviadas();
+uint32_t matriz_atualizacoes_puladas();
+void mostrar_numero_vidas(int vidas, bool pausado);
 void desligar_matriz();
 
 #endif // MATRIZ_LED_H
\ No newline at end of file
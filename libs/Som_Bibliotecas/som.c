@@ -0,0 +1,121 @@
+#include "som.h"
+#include "hardware/pwm.h"
+#include "hardware/clocks.h"
+#include "hardware/sync.h"
+
+typedef struct {
+    uint pino;
+    uint slice;
+    uint canal_pwm;
+    nota_t fila[SOM_MAX_NOTAS];
+    volatile uint8_t inicio;   // Consumido pelo alarme
+    volatile uint8_t fim;      // Produzido pelo laço principal
+    volatile bool tocando;     // Há um alarme agendado para este canal
+    alarm_id_t alarme;
+} canal_som_t;
+
+static canal_som_t canais[SOM_NUM_CANAIS];
+
+static void aplicar_frequencia(canal_som_t *c, uint16_t frequencia_hz) {
+    if (frequencia_hz == 0) {
+        pwm_set_chan_level(c->slice, c->canal_pwm, 0);
+        return;
+    }
+    // Menor divisor inteiro que mantém o contador em 16 bits, ciclo de trabalho de 50%
+    uint32_t clock = clock_get_hz(clk_sys);
+    uint32_t divisor = clock / ((uint32_t)frequencia_hz * 65536u) + 1;
+    if (divisor > 255) divisor = 255;
+    uint32_t topo = clock / (divisor * frequencia_hz) - 1;
+    if (topo > 0xFFFF) topo = 0xFFFF;
+    pwm_set_clkdiv_int_frac(c->slice, (uint8_t)divisor, 0);
+    pwm_set_wrap(c->slice, (uint16_t)topo);
+    pwm_set_chan_level(c->slice, c->canal_pwm, (uint16_t)(topo / 2));
+}
+
+// Toca a próxima nota da fila e agenda a seguinte; roda no IRQ do timer
+static int64_t avancar_nota(alarm_id_t id, void *dados) {
+    canal_som_t *c = (canal_som_t *)dados;
+    // Nota de 0 ms não soa: retornar 0 daqui desligaria o alarme com o canal ainda tocando
+    while (c->inicio != c->fim && c->fila[c->inicio].duracao_ms == 0) {
+        c->inicio = (c->inicio + 1) & (SOM_MAX_NOTAS - 1);
+    }
+    if (c->inicio == c->fim) {
+        aplicar_frequencia(c, 0);
+        c->tocando = false;
+        return 0;
+    }
+    nota_t nota = c->fila[c->inicio];
+    c->inicio = (c->inicio + 1) & (SOM_MAX_NOTAS - 1);
+    aplicar_frequencia(c, nota.frequencia_hz);
+    // Negativo: relativo ao prazo anterior, sem acumular atraso entre notas
+    return -(int64_t)nota.duracao_ms * 1000;
+}
+
+void som_iniciar(uint pino_canal_0, uint pino_canal_1) {
+    uint pinos[SOM_NUM_CANAIS] = { pino_canal_0, pino_canal_1 };
+    for (uint8_t i = 0; i < SOM_NUM_CANAIS; i++) {
+        canal_som_t *c = &canais[i];
+        c->pino = pinos[i];
+        c->slice = pwm_gpio_to_slice_num(c->pino);
+        c->canal_pwm = pwm_gpio_to_channel(c->pino);
+        c->inicio = 0;
+        c->fim = 0;
+        c->tocando = false;
+        gpio_set_function(c->pino, GPIO_FUNC_PWM);
+        pwm_set_chan_level(c->slice, c->canal_pwm, 0);
+        pwm_set_enabled(c->slice, true);
+    }
+}
+
+bool som_enfileirar(uint8_t canal, const nota_t *notas, uint8_t quantidade) {
+    if (canal >= SOM_NUM_CANAIS) return false;
+    canal_som_t *c = &canais[canal];
+
+    uint8_t livres = (SOM_MAX_NOTAS - 1) - ((c->fim - c->inicio) & (SOM_MAX_NOTAS - 1));
+    if (quantidade > livres) return false;
+
+    uint8_t fim = c->fim;
+    for (uint8_t i = 0; i < quantidade; i++) {
+        c->fila[fim] = notas[i];
+        fim = (fim + 1) & (SOM_MAX_NOTAS - 1);
+    }
+
+    // O alarme pode estar terminando a fila agora; decide com o IRQ desligado
+    uint32_t estado = save_and_disable_interrupts();
+    c->fim = fim;
+    bool iniciar = !c->tocando;
+    if (iniciar) c->tocando = true;
+    restore_interrupts(estado);
+
+    if (iniciar) {
+        c->alarme = add_alarm_in_us(0, avancar_nota, c, true);
+        if (c->alarme < 0) {
+            c->tocando = false;
+            return false;
+        }
+    }
+    return true;
+}
+
+bool som_tocar(uint8_t canal, uint16_t frequencia_hz, uint16_t duracao_ms) {
+    nota_t nota = { frequencia_hz, duracao_ms };
+    return som_enfileirar(canal, &nota, 1);
+}
+
+void som_parar(uint8_t canal) {
+    if (canal >= SOM_NUM_CANAIS) return;
+    canal_som_t *c = &canais[canal];
+
+    uint32_t estado = save_and_disable_interrupts();
+    bool tocando = c->tocando;
+    c->inicio = c->fim;
+    c->tocando = false;
+    restore_interrupts(estado);
+
+    if (tocando) cancel_alarm(c->alarme);
+    aplicar_frequencia(c, 0);
+}
+
+bool som_ocupado(uint8_t canal) {
+    return canal < SOM_NUM_CANAIS && canais[canal].tocando;
+}
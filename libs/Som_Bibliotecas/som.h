@@ -0,0 +1,22 @@
+#ifndef SOM_H
+#define SOM_H
+
+#include "pico/stdlib.h"
+
+#define SOM_NUM_CANAIS 2
+#define SOM_MAX_NOTAS 16   // Capacidade da fila de cada canal (potência de 2)
+
+// Uma nota da fila; frequência 0 é pausa
+typedef struct {
+    uint16_t frequencia_hz;
+    uint16_t duracao_ms;
+} nota_t;
+
+// Cada canal usa o slice PWM do seu pino; os dois pinos não podem dividir o mesmo slice
+void som_iniciar(uint pino_canal_0, uint pino_canal_1);
+bool som_tocar(uint8_t canal, uint16_t frequencia_hz, uint16_t duracao_ms);
+bool som_enfileirar(uint8_t canal, const nota_t *notas, uint8_t quantidade);
+void som_parar(uint8_t canal);
+bool som_ocupado(uint8_t canal);
+
+#endif // SOM_H
@@ -7,8 +7,48 @@
 #include "hardware/i2c.h"
 #include "hardware/adc.h"
 #include "hardware/pwm.h"
-#include "libs\Display_Bibliotecas\ssd1306.h"
-#include "libs\Matriz_Bibliotecas\matriz_led.h"
+#include "hardware/sync.h"
+#include "libs/Display_Bibliotecas/ssd1306.h"
+#include "libs/Display_Bibliotecas/framebuffer.h"
+#include "libs/Display_Bibliotecas/sprite.h"
+#include "libs/Display_Bibliotecas/compositor.h"
+#include "assets/jogador.h"
+#include "assets/coletavel.h"
+#include "libs/Matriz_Bibliotecas/matriz_led.h"
+#include "libs/Som_Bibliotecas/som.h"
+#include "libs/Joystick_Bibliotecas/joystick.h"
+#include "libs/Jogo_Bibliotecas/agendador.h"
+#include "libs/Jogo_Bibliotecas/anel_quadros.h"
+#include "libs/Jogo_Bibliotecas/aleatorio.h"
+#include "libs/Jogo_Bibliotecas/posicionamento.h"
+#include "libs/Jogo_Bibliotecas/entidades.h"
+#include "libs/Jogo_Bibliotecas/botoes.h"
+#include "libs/Jogo_Bibliotecas/gravacao.h"
+#include "libs/Jogo_Bibliotecas/perfil.h"
+#include "libs/Jogo_Bibliotecas/telemetria.h"
+#include "libs/Jogo_Bibliotecas/espelho.h"
+#include "pico/multicore.h"
+#include "tusb.h"
+
+// 1: o núcleo 1 envia o display e a matriz LED; o núcleo 0 só produz quadros
+#ifndef RENDER_NUCLEO1
+#define RENDER_NUCLEO1 0
+#endif
+
+// 1: grava semente, entradas de cada passo e hash de cada quadro no serial (linhas "#G")
+#ifndef GRAVAR_ENTRADAS
+#define GRAVAR_ENTRADAS 0
+#endif
+
+// 1: tenta o OLED em 1 MHz (Fast-mode Plus) e volta para 400 kHz no primeiro NAK ou erro de barramento
+#ifndef I2C_FM_PLUS
+#define I2C_FM_PLUS 0
+#endif
+
+// 1: espelha o OLED no USB junto com a telemetria; tools/espelho_tela.py remonta os quadros
+#ifndef ESPELHAR_TELA
+#define ESPELHAR_TELA 0
+#endif
 
 // ─── Definições de Hardware ──────────────────────────────────────────────
 #define PINO_JOYSTICK_X        27  // Pino ADC para eixo X do joystick
@@ -32,6 +72,10 @@
 #define I2C_SDA_PIN            14
 #define I2C_SCL_PIN            15
 #define I2C_FREQUENCIA         400000
+#define I2C_FREQUENCIA_FM_PLUS 1000000
+
+// Desenho com a geometria fixa do framebuffer_128x64_*
+_Static_assert(LARGURA_TELA == 128 && ALTURA_TELA == 64, "o desenho usa o framebuffer 128x64");
 
 // ─── Parâmetros do Jogo ─────────────────────────────────────────────────
 #define TAMANHO_JOGADOR        8    // Tamanho do quadrado do jogador em px
@@ -41,22 +85,96 @@
 #define VELOCIDADE            2     // Velocidade do jogador em px por quadro
 #define TEMPO_CALIBRAGEM_MS   2000  // Tempo de calibração inicial em ms
 #define MAX_VIDAS             3     // Vidas iniciais
+#define DURACAO_IMUNE_MS      1500  // Imunidade após perder uma vida
+#define PASSO_LOGICA_US       30000 // Período fixo da lógica do jogo
+#define PERIODO_RENDER_US     30000 // Período mínimo entre quadros desenhados
+#define PERIODO_TELA_PARADA_US 1000000 // Telemetria e serial do perfil nas telas sem animação
+#define PASSO_ANIMACAO_MS     300   // Um passo do contraste da abertura
+#define CONTRASTE_PAUSA       0x10  // A pausa só escurece o OLED, sem reenviar a imagem
+#define INVERSAO_GAME_OVER_MS 600   // O game over entra com a tela invertida por este tempo
+#define PAGINA_LETREIRO       5     // "[B] START" corre pela rolagem do OLED nas páginas 5 e 6
+#define PISCA_IMUNE_MS        150   // Meio período do pisca do jogador imune
+#define PASSO_COLETAVEL_MS    300   // Um quadro da animação do pixel coletável
+
+// ─── Área reservada para a pontuação (o pixel não nasce nela) ───────────────
+#define AREA_PONTOS_X         2
+#define AREA_PONTOS_Y         2
+#define AREA_PONTOS_LARGURA   50
+#define AREA_PONTOS_ALTURA    10
+
+// ─── Sprites, compilados de assets/sprites/ pelo tools/compilar_assets.py ───
+_Static_assert(SPRITE_JOGADOR_LARGURA == TAMANHO_JOGADOR && SPRITE_JOGADOR_ALTURA == TAMANHO_JOGADOR,
+               "assets/sprites/jogador.pbm tem o tamanho do jogador");
+_Static_assert(SPRITE_COLETAVEL_LARGURA == TAMANHO_PIXEL && SPRITE_COLETAVEL_ALTURA == TAMANHO_PIXEL,
+               "assets/sprites/coletavel.pbm tem o tamanho do pixel");
+
+// ─── Índices dos botões na fila de eventos ───────────────────────────────────
+#define BOTAO_B               0
+#define BOTAO_A               1
+#define BOTAO_JOYSTICK        2    // Na gravação cada botão é o bit 1 << índice
+
+// ─── Índices das exclusões no posicionamento do pixel ───────────────────────
+#define EXCLUSAO_PONTOS       0
+#define EXCLUSAO_JOGADOR      1
 
 // ─── Variáveis Globais ─────────────────────────────────────────────────
-volatile bool jogo_iniciado = false;
-volatile bool jogo_pausado = false;
-static uint32_t ultimo_pulso_ms = 0;
-static uint32_t ultimo_pulso_A_ms = 0;
-static uint32_t ultimo_pulso_joystick_ms = 0;
-static uint32_t quadro_splash = 0;
-
-ssd1306_t display;
-int posicao_jogador_x, posicao_jogador_y;
-int posicao_pixel_x, posicao_pixel_y;
+bool jogo_iniciado = false;
+bool jogo_pausado = false;
+
+// Telas fora da partida ficam retidas no OLED: só são redesenhadas quando o conteúdo muda
+typedef enum {
+    TELA_JOGO,                         // Quadros da partida, sempre redesenhados
+    TELA_INICIAL,
+    TELA_PAUSA,
+    TELA_GAME_OVER,
+} tela_t;
+static tela_t tela_mostrada = TELA_JOGO;
+static uint32_t conteudo_mostrado;     // Tudo que muda o desenho da tela retida
+static uint64_t fim_inversao_us;       // Até quando o game over fica invertido
+
+// Efeitos que o próprio controlador do OLED faz: só bytes de comando, a imagem não é reenviada
+typedef struct {
+    uint8_t contraste;
+    bool invertida;
+    bool letreiro;                     // Rolagem horizontal das páginas do "[B] START"
+} efeitos_t;
+#define EFEITOS_NORMAIS ((efeitos_t){ SSD1306_CONTRAST_DEFAULT, false, false })
+static efeitos_t efeitos_pedidos = EFEITOS_NORMAIS;   // Vão com o próximo quadro apresentado
+static efeitos_t efeitos_mostrados = EFEITOS_NORMAIS;
+static const uint8_t contraste_abertura[] = { 0xFF, 0xB0, 0x70, 0x40, 0x20, 0x40, 0x70, 0xB0 };
+uint32_t telas_desenhadas = 0;         // Telas retidas redesenhadas e enviadas
+uint32_t despertares_ociosos = 0;      // Saídas do __wfi sem prazo vencido nem botão
+
+ssd1306_t display;                     // Tela onde o jogo desenha
+
+// A tela de jogo é o OU de três camadas; só o que mudou nelas é recomposto no display
+enum { CAMADA_BORDA, CAMADA_HUD, CAMADA_SPRITES, NUM_CAMADAS };
+compositor_t compositor;
+static bool camadas_ativas = false;    // Falso se faltou memória para as camadas: quadro inteiro direto no display
+static bool camadas_compostas = false;  // Falso depois que uma tela retida desenhou no display
+static int pontuacao_hud = -1;         // Pontuação que está desenhada na camada do HUD
+uint32_t palavras_compostas = 0;       // Palavras de 32 bits escritas no display pela composição
+uint32_t redesenhos_hud = 0;
+entidades_t entidades;                 // Jogador e pixels em estrutura de arrays
+grade_t grade;                         // Grade de colisão, remontada a cada passo
+entidade_id_t id_jogador, id_pixel;
 int pontuacao = 0;
 int vidas = MAX_VIDAS;
 bool fim_de_jogo = false;
 int centro_x = 2048, centro_y = 2048;  // Médias do joystick após calibração
+uint32_t tempo_imune = 0;              // Fim da imunidade em tempo lógico (0 = sem imunidade)
+agendador_t agendador;
+posicionamento_t posicionamento_pixel;  // Posições livres para o pixel nascer
+void (*fonte_entrada)(uint16_t *x, uint16_t *y) = joystick_ler;  // Trocada pelo reprodutor de gravações
+#if GRAVAR_ENTRADAS
+gravacao_t gravacao;
+#endif
+telemetria_t telemetria;
+#if ESPELHAR_TELA
+espelho_t espelho;                     // Último OLED que o visualizador do host recebeu
+#endif
+botoes_t botoes;                       // Apertos já sem ressalto, vindos da IRQ de GPIO
+static uint16_t ultima_entrada_x = 2048, ultima_entrada_y = 2048;  // Joystick lido no último passo
 
 // ─── Funções para controle dos LEDs ───────────────────────────────────────
 void inicializar_leds() {
@@ -96,103 +214,62 @@ void atualizar_leds() {
     }
 }
 
-// ─── Função de Leitura ADC ─────────────────────────────────────────────────
-static inline int ler_adc(int canal) {
-    adc_select_input(canal);
-    return adc_read();
+// ─── Gravação de entradas ────────────────────────────────────────────────
+#if GRAVAR_ENTRADAS
+// Um registro por linha em hexadecimal; tools/extrair_gravacao.py remonta o arquivo binário
+void enviar_gravacao(const uint8_t *bytes, size_t n) {
+    printf("#G ");
+    for (size_t i = 0; i < n; i++) printf("%02x", bytes[i]);
+    printf("\n");
 }
+#endif
 
-// Protótipos de funções para callbacks
-void callback_botao_B(uint gpio, uint32_t event);
-void callback_botao_A(uint gpio, uint32_t event);
-void callback_botao_joystick(uint gpio, uint32_t event);
-
-// ─── Trata o botão B com debounce ─────────────────────────────────────────
-void callback_botao_B(uint gpio, uint32_t event) {
-    uint32_t agora_ms = to_ms_since_boot(get_absolute_time());
-    if (agora_ms - ultimo_pulso_ms < 200) return;
-    ultimo_pulso_ms = agora_ms;
+// ─── Botões: uma IRQ para todos os pinos, apertos tratados no laço principal ───
+_Static_assert(BOTOES_DESCIDA == GPIO_IRQ_EDGE_FALL && BOTOES_SUBIDA == GPIO_IRQ_EDGE_RISE,
+               "botoes_borda recebe a máscara da IRQ como ela vem");
 
-    if (fim_de_jogo) {
-        // Reinicia o jogo após Game Over
-        fim_de_jogo = false;
-        jogo_iniciado = true;
-        atualizar_leds();
-    } else if (!jogo_iniciado) {
-        jogo_iniciado = true;
-        atualizar_leds();
-    }
+// O SDK guarda um só callback de GPIO por núcleo, então todos os pinos passam por aqui
+void tratar_irq_gpio(uint gpio, uint32_t eventos) {
+    botoes_borda(&botoes, gpio, eventos, !gpio_get(gpio), time_us_32());
 }
 
-// ─── Trata o botão A (Pausa) com debounce ───────────────────────────────────
-void callback_botao_A(uint gpio, uint32_t event) {
-    uint32_t agora_ms = to_ms_since_boot(get_absolute_time());
-    if (agora_ms - ultimo_pulso_A_ms < 200) return;
-    ultimo_pulso_A_ms = agora_ms;
-
-    if (jogo_iniciado && !fim_de_jogo) {
-        jogo_pausado = !jogo_pausado;
-        atualizar_leds();
-    }
-}
-
-// ─── Trata o botão do joystick (Pausa) com debounce ───────────────────────────────────
-void callback_botao_joystick(uint gpio, uint32_t event) {
-    uint32_t agora_ms = to_ms_since_boot(get_absolute_time());
-    if (agora_ms - ultimo_pulso_joystick_ms < 200) return;
-    ultimo_pulso_joystick_ms = agora_ms;
-
-    if (jogo_iniciado && !fim_de_jogo) {
-        jogo_pausado = !jogo_pausado;
-        atualizar_leds();
+void inicializar_botoes() {
+    static const uint8_t pinos[] = { PINO_BOTAO, PINO_BOTAO_A, PINO_BOTAO_JOYSTICK };  // Na ordem de BOTAO_*
+    botoes_iniciar(&botoes, pinos, sizeof(pinos), time_us_32());
+    for (size_t i = 0; i < sizeof(pinos); i++) {
+        gpio_init(pinos[i]);
+        gpio_set_dir(pinos[i], GPIO_IN);
+        gpio_pull_up(pinos[i]);
+        // As subidas também entram: é por elas que se vê o ressalto da soltura
+        gpio_set_irq_enabled_with_callback(pinos[i], GPIO_IRQ_EDGE_FALL | GPIO_IRQ_EDGE_RISE, true, tratar_irq_gpio);
     }
 }
 
-void inicializar_botoes() {
-    // Inicializa botão B (Start/Restart)
-    gpio_init(PINO_BOTAO);
-    gpio_set_dir(PINO_BOTAO, GPIO_IN);
-    gpio_pull_up(PINO_BOTAO);
-    gpio_set_irq_enabled_with_callback(PINO_BOTAO, GPIO_IRQ_EDGE_FALL, true, callback_botao_B);
-
-    // Inicializa botão A (Pause)
-    gpio_init(PINO_BOTAO_A);
-    gpio_set_dir(PINO_BOTAO_A, GPIO_IN);
-    gpio_pull_up(PINO_BOTAO_A);
-    gpio_set_irq_enabled_with_callback(PINO_BOTAO_A, GPIO_IRQ_EDGE_FALL, true, callback_botao_A);
-
-    // Inicializa botão do joystick (Pause)
-    gpio_init(PINO_BOTAO_JOYSTICK);
-    gpio_set_dir(PINO_BOTAO_JOYSTICK, GPIO_IN);
-    gpio_pull_up(PINO_BOTAO_JOYSTICK);
-    gpio_set_irq_enabled_with_callback(PINO_BOTAO_JOYSTICK, GPIO_IRQ_EDGE_FALL, true, callback_botao_joystick);
-}
-
-// ─── Desenha retângulo preenchido ────────────────────────────────────────
-void desenhar_retangulo(ssd1306_t *display, int x, int y, int largura, int altura) {
-    for (int i = x; i < x + largura; i++) {
-        for (int j = y; j < y + altura; j++) {
-            ssd1306_pixel(display, i, j, true);
+// B inicia e reinicia; A e o botão do joystick pausam e despausam a partida
+void atender_botoes() {
+    evento_botao_t evento;
+    while (botoes_proximo(&botoes, &evento)) {
+#if GRAVAR_ENTRADAS
+        gravacao_botao(&gravacao, (uint8_t)(1u << evento.botao));
+#endif
+        if (evento.botao == BOTAO_B) {
+            if (fim_de_jogo || !jogo_iniciado) {
+                fim_de_jogo = false;
+                jogo_iniciado = true;
+            }
+        } else if (jogo_iniciado && !fim_de_jogo) {
+            jogo_pausado = !jogo_pausado;
         }
+        atualizar_leds();
     }
 }
 
 // ─── Desenha somente a borda ─────────────────────────────────────────────
 void desenhar_borda(ssd1306_t *display, int x, int y, int largura, int altura, int espessura) {
-    for (int i = x; i < x + largura; i++) {
-        ssd1306_pixel(display, i, y, true);
-        ssd1306_pixel(display, i, y + altura - 1, true);
-    }
-    for (int j = y; j < y + altura; j++) {
-        ssd1306_pixel(display, x, j, true);
-        ssd1306_pixel(display, x + largura - 1, j, true);
-    }
-}
-
-// ─── Verifica colisão entre dois retângulos ───────────────────────────────
-bool verificar_colisao(int ax, int ay, int largura_a, int altura_a, int bx, int by, int largura_b, int altura_b) {
-    // Verifica se há sobreposição nos eixos X e Y
-    return ax < bx + largura_b && ax + largura_a > bx && ay < by + altura_b && ay + altura_a > by;
+    framebuffer_128x64_fill_rect(display, x, y, largura, 1, true);
+    framebuffer_128x64_fill_rect(display, x, y + altura - 1, largura, 1, true);
+    framebuffer_128x64_fill_rect(display, x, y, 1, altura, true);
+    framebuffer_128x64_fill_rect(display, x + largura - 1, y, 1, altura, true);
 }
 
 // ─── Verifica colisão com as bordas da tela ───────────────────────────────
@@ -201,104 +278,455 @@ bool verificar_colisao_borda(int x, int y, int largura, int altura) {
     return x < BORDAS || y < BORDAS || x + largura > LARGURA_TELA - BORDAS || y + altura > ALTURA_TELA - BORDAS;
 }
 
-// ─── Mostra pontuação e vidas no OLED ────────────────────────────────────
+// ─── Camadas fixas: a borda uma vez no boot, o HUD só quando a pontuação muda ───
+void iniciar_camadas() {
+    camadas_ativas = compositor_init(&compositor, &display, NUM_CAMADAS);
+    if (!camadas_ativas) {
+        printf("Sem memória para as camadas: desenhando direto no display\n");
+        return;
+    }
+    desenhar_borda(compositor_layer(&compositor, CAMADA_BORDA), 0, 0, LARGURA_TELA, ALTURA_TELA, BORDAS);
+}
+
 void desenhar_pontuacao() {
+    if (camadas_ativas && pontuacao == pontuacao_hud) return;
     char buffer[20];
     sprintf(buffer, "Pontos: %d", pontuacao);
-    ssd1306_draw_string(&display, buffer, 2, 2, false);
+    ssd1306_t *hud = &display;
+    if (camadas_ativas) {
+        compositor_erase(&compositor, CAMADA_HUD);
+        hud = compositor_layer(&compositor, CAMADA_HUD);
+    }
+    ssd1306_draw_string(hud, buffer, 2, 2, false);
+    pontuacao_hud = pontuacao;
+    redesenhos_hud++;
 }
 
-void desenhar_vidas() {
-    mostrar_numero_vidas(vidas);
+// ─── Saída do quadro: direto ou pelo núcleo 1 ────────────────────────────
+uint32_t oled_config_us = 0;           // Duração do ssd1306_config no boot
+
+void configurar_oled(ssd1306_t *oled) {
+#if I2C_FM_PLUS
+    ssd1306_set_baudrate(oled, I2C_FREQUENCIA_FM_PLUS, I2C_FREQUENCIA);
+#endif
+    uint64_t inicio = time_us_64();
+    ssd1306_config(oled);
+    oled_config_us = (uint32_t)(time_us_64() - inicio);
 }
 
-// ─── Tela inicial animada ────────────────────────────────────────────────
-void tela_inicial() {
-    quadro_splash++;
-    bool pisca = ((quadro_splash / 30) % 2) == 0;
-    int deslocamento = (quadro_splash / 20) % 4;
-
-    ssd1306_fill(&display, false);
-    ssd1306_pixel(&display, 5, 5, true);
-    ssd1306_pixel(&display, LARGURA_TELA - 6, 5, true);
-    ssd1306_pixel(&display, 5, ALTURA_TELA - 6, true);
-    ssd1306_pixel(&display, LARGURA_TELA - 6, ALTURA_TELA - 6, true);
-
-    for (int i = deslocamento; i < LARGURA_TELA - deslocamento; i++) {
-        ssd1306_pixel(&display, i, deslocamento, true);
-        ssd1306_pixel(&display, i, ALTURA_TELA - 1 - deslocamento, true);
+// Depois da imagem: o envio com mudanças já parou a rolagem, então ela recomeça sobre o quadro novo
+void aplicar_efeitos(ssd1306_t *oled, uint8_t contraste, bool invertida, bool letreiro) {
+    static const ssd1306_scroll_t rolagem_letreiro = {
+        SSD1306_SCROLL_LEFT, PAGINA_LETREIRO, PAGINA_LETREIRO + 1, SSD1306_SCROLL_5_FRAMES, 0
+    };
+    ssd1306_contrast(oled, contraste);
+    ssd1306_invert(oled, invertida);
+    if (letreiro) ssd1306_scroll(oled, &rolagem_letreiro);
+    else ssd1306_scroll_stop(oled);
+}
+
+#if RENDER_NUCLEO1
+ssd1306_t painel;                      // Dono do barramento I2C, usado só pelo núcleo 1
+anel_quadros_t anel_quadros;
+static int vidas_exibidas = MAX_VIDAS; // Vai para a matriz junto com o próximo quadro
+
+// Núcleo 1: apresenta sempre o quadro mais novo publicado pelo núcleo 0
+void nucleo1_principal() {
+    while (true) {
+        multicore_fifo_pop_blocking();
+        quadro_t *quadro;
+        while ((quadro = anel_quadros_proximo(&anel_quadros)) != NULL) {
+            ssd1306_load_frame(&painel, quadro->tela);
+            int vidas_quadro = quadro->vidas;
+            bool pausado_quadro = quadro->pausado;
+            efeitos_t efeitos = { quadro->contraste, quadro->invertida, quadro->letreiro };
+            anel_quadros_liberar(&anel_quadros);
+
+            ssd1306_send_data(&painel);
+            aplicar_efeitos(&painel, efeitos.contraste, efeitos.invertida, efeitos.letreiro);
+            if (vidas_quadro < 0) desligar_matriz();
+            else mostrar_numero_vidas(vidas_quadro, pausado_quadro);
+        }
+    }
+}
+#endif
+
+void exibir_vidas(int numero) {
+    PERFIL_INICIO(PERFIL_MATRIZ);
+#if RENDER_NUCLEO1
+    vidas_exibidas = numero;
+#else
+    if (numero < 0) desligar_matriz();
+    else mostrar_numero_vidas(numero, jogo_pausado);
+#endif
+    PERFIL_FIM();
+}
+
+// false se o quadro foi descartado
+bool apresentar_quadro() {
+    PERFIL_INICIO(PERFIL_ENVIO_DISPLAY);
+#if RENDER_NUCLEO1
+    // Anel cheio: o quadro é descartado em vez de esperar o barramento
+    quadro_t *quadro = anel_quadros_reservar(&anel_quadros);
+    if (quadro == NULL) {
+        PERFIL_FIM();
+        return false;
     }
-    for (int j = deslocamento; j < ALTURA_TELA - deslocamento; j++) {
-        ssd1306_pixel(&display, deslocamento, j, true);
-        ssd1306_pixel(&display, LARGURA_TELA - 1 - deslocamento, j, true);
+    memcpy(quadro->tela, &display.ram_buffer[1], sizeof(quadro->tela));
+    quadro->vidas = vidas_exibidas;
+    quadro->pausado = jogo_pausado;
+    quadro->contraste = efeitos_pedidos.contraste;
+    quadro->invertida = efeitos_pedidos.invertida;
+    quadro->letreiro = efeitos_pedidos.letreiro;
+    uint32_t sequencia = anel_quadros_publicar(&anel_quadros);
+    if (multicore_fifo_wready()) multicore_fifo_push_blocking(sequencia);
+#else
+    ssd1306_send_data_async(&display);
+    aplicar_efeitos(&display, efeitos_pedidos.contraste, efeitos_pedidos.invertida, efeitos_pedidos.letreiro);
+#endif
+    efeitos_mostrados = efeitos_pedidos;
+    PERFIL_FIM();
+    return true;
+}
+
+void desenhar_vidas() {
+    exibir_vidas(vidas);
+}
+
+// ─── Telas retidas ────────────────────────────────────────────────────────
+static bool tela_atual(tela_t tela, uint32_t conteudo) {
+    return tela_mostrada == tela && conteudo_mostrado == conteudo;
+}
+
+// Com o anel do núcleo 1 cheio o quadro não sai, e a tela é tentada de novo logo depois
+static void reter_tela(tela_t tela, uint32_t conteudo) {
+    camadas_compostas = false;
+    telas_desenhadas++;
+    if (!apresentar_quadro()) return;
+    tela_mostrada = tela;
+    conteudo_mostrado = conteudo;
+}
+
+// Só os efeitos mudaram: o quadro vai igual e o envio não tem bytes de imagem
+static void pedir_efeitos(efeitos_t efeitos) {
+    efeitos_pedidos = efeitos;
+    if (memcmp(&efeitos_pedidos, &efeitos_mostrados, sizeof(efeitos_t)) != 0) apresentar_quadro();
+}
+
+static uint64_t prazo_tela(tela_t tela, uint32_t conteudo, uint64_t prazo_us) {
+    return tela_atual(tela, conteudo) ? prazo_us : time_us_64() + PERIODO_RENDER_US;
+}
+
+static int64_t acordar(alarm_id_t id, void *dados) {
+    return 0;
+}
+
+// Dorme em __wfi até o prazo ou até um aperto chegar na fila; o alarme no prazo garante que
+// alguma interrupção acorde o núcleo. Com as interrupções desligadas entre a conferência e o
+// __wfi, uma IRQ que chegue nesse meio ainda acorda o núcleo em vez de se perder.
+void dormir_ate(uint64_t prazo_us) {
+    PERFIL_INICIO(PERFIL_OCIOSO);
+    uint64_t agora = time_us_64();
+    alarm_id_t alarme = agora < prazo_us ? add_alarm_in_us(prazo_us - agora, acordar, NULL, true) : 0;
+    for (;;) {
+        uint32_t estado = save_and_disable_interrupts();
+        bool pronto = time_us_64() >= prazo_us || botoes_pendentes(&botoes);
+        if (!pronto) __wfi();
+        restore_interrupts(estado);
+        if (pronto) break;
+        despertares_ociosos++;
     }
+    if (alarme > 0) cancel_alarm(alarme);
+    PERFIL_FIM();
+}
 
-    ssd1306_draw_string(&display, "BitRun", (LARGURA_TELA - 6 * 6) / 2, 12, false);
-    if (pisca) {
+// ─── Tela inicial animada ────────────────────────────────────────────────
+// Desenhada uma vez: o letreiro corre pela rolagem do OLED e o contraste pulsa por comando.
+// Devolve quando o contraste muda de novo
+uint64_t tela_inicial() {
+    PERFIL_INICIO(PERFIL_TELA_INICIAL);
+    uint32_t passo = to_ms_since_boot(get_absolute_time()) / PASSO_ANIMACAO_MS;
+    size_t niveis = sizeof(contraste_abertura) / sizeof(contraste_abertura[0]);
+    efeitos_t efeitos = { contraste_abertura[passo % niveis], false, true };
+
+    if (!tela_atual(TELA_INICIAL, 0)) {
+        exibir_vidas(MAX_VIDAS);
+        framebuffer_128x64_fill(&display, false);
+        framebuffer_128x64_pixel(&display, 5, 5, true);
+        framebuffer_128x64_pixel(&display, LARGURA_TELA - 6, 5, true);
+        framebuffer_128x64_pixel(&display, 5, ALTURA_TELA - 6, true);
+        framebuffer_128x64_pixel(&display, LARGURA_TELA - 6, ALTURA_TELA - 6, true);
+
+        // As páginas do letreiro correm inteiras, então a borda tem uma abertura nelas
+        desenhar_borda(&display, 0, 0, LARGURA_TELA, ALTURA_TELA, 1);
+        framebuffer_128x64_fill_rect(&display, 0, PAGINA_LETREIRO * 8, LARGURA_TELA, 16, false);
+
+        ssd1306_draw_string(&display, "BitRun", (LARGURA_TELA - 6 * 6) / 2, 12, false);
         ssd1306_draw_string(&display, "[B] START", (LARGURA_TELA - 7 * 6) / 2, ALTURA_TELA - 18, false);
         ssd1306_draw_string(&display, ">", (LARGURA_TELA - 7 * 6) / 2 - 8, ALTURA_TELA - 18, false);
+        efeitos_pedidos = efeitos;
+        reter_tela(TELA_INICIAL, 0);
     }
-    ssd1306_send_data(&display);
+    pedir_efeitos(efeitos);
+    uint64_t proxima_mudanca_us = (uint64_t)(passo + 1) * PASSO_ANIMACAO_MS * 1000;
+    PERFIL_FIM();
+    return prazo_tela(TELA_INICIAL, 0, proxima_mudanca_us);
 }
 
 // ─── Tela de pausa ────────────────────────────────────────────────────────
-void tela_pausa() {
-    ssd1306_fill(&display, false);
-    ssd1306_draw_string(&display, "JOGO PAUSADO", (LARGURA_TELA - 12 * 6) / 2, 20, false);
-    ssd1306_draw_string(&display, "A Continuar", (LARGURA_TELA - 12 * 6) / 2, ALTURA_TELA - 20, false);
-    ssd1306_send_data(&display);
-    desenhar_vidas();
+uint64_t tela_pausa() {
+    PERFIL_INICIO(PERFIL_TELA_PAUSA);
+    efeitos_t efeitos = { CONTRASTE_PAUSA, false, false };
+    if (!tela_atual(TELA_PAUSA, (uint32_t)vidas)) {
+        framebuffer_128x64_fill(&display, false);
+        ssd1306_draw_string(&display, "JOGO PAUSADO", (LARGURA_TELA - 12 * 6) / 2, 20, false);
+        ssd1306_draw_string(&display, "A Continuar", (LARGURA_TELA - 12 * 6) / 2, ALTURA_TELA - 20, false);
+        desenhar_vidas();
+        efeitos_pedidos = efeitos;
+        reter_tela(TELA_PAUSA, (uint32_t)vidas);
+    }
+    pedir_efeitos(efeitos);
+    PERFIL_FIM();
+    return prazo_tela(TELA_PAUSA, (uint32_t)vidas, time_us_64() + PERIODO_TELA_PARADA_US);
 }
 
 // ─── Tela de Game Over ──────────────────────────────────────────────────
-void tela_game_over() {
-    ssd1306_fill(&display, false);
-    ssd1306_draw_string(&display, "GAME OVER", (LARGURA_TELA - 9 * 6) / 2, 16, false);
-    char buffer[20];
-    sprintf(buffer, "Pontos: %d", pontuacao);
-    ssd1306_draw_string(&display, buffer, (LARGURA_TELA - strlen(buffer) * 6) / 2, 32, false);
-    ssd1306_draw_string(&display, "[B] Reinicia", (LARGURA_TELA - 11 * 6) / 2, ALTURA_TELA - 16, false);
-    ssd1306_send_data(&display);
+uint64_t tela_game_over() {
+    PERFIL_INICIO(PERFIL_TELA_GAME_OVER);
+    uint64_t agora_us = time_us_64();
+    if (!tela_atual(TELA_GAME_OVER, (uint32_t)pontuacao)) {
+        fim_inversao_us = agora_us + INVERSAO_GAME_OVER_MS * 1000ull;
+        framebuffer_128x64_fill(&display, false);
+        ssd1306_draw_string(&display, "GAME OVER", (LARGURA_TELA - 9 * 6) / 2, 16, false);
+        char buffer[20];
+        sprintf(buffer, "Pontos: %d", pontuacao);
+        ssd1306_draw_string(&display, buffer, (LARGURA_TELA - strlen(buffer) * 6) / 2, 32, false);
+        ssd1306_draw_string(&display, "[B] Reinicia", (LARGURA_TELA - 11 * 6) / 2, ALTURA_TELA - 16, false);
+        exibir_vidas(0);
+        efeitos_pedidos = (efeitos_t){ SSD1306_CONTRAST_DEFAULT, true, false };
+        reter_tela(TELA_GAME_OVER, (uint32_t)pontuacao);
+    }
+    bool invertida = agora_us < fim_inversao_us;
+    pedir_efeitos((efeitos_t){ SSD1306_CONTRAST_DEFAULT, invertida, false });
+    PERFIL_FIM();
+    return prazo_tela(TELA_GAME_OVER, (uint32_t)pontuacao, invertida ? fim_inversao_us : agora_us + PERIODO_TELA_PARADA_US);
 }
 
 // ─── Funções para controle dos buzzers ───────────────────────────────────────
+#define CANAL_BUZZER_A 0  // Coleta de pixel
+#define CANAL_BUZZER_B 1  // Game over
+
+// Tocados via PWM + alarme do timer, sem custo para o laço do jogo
+static const nota_t som_pixel[] = {
+    { 1000, 100 },  // Curto e agudo
+};
+static const nota_t som_game_over[] = {
+    { 500, 1000 },  // Longo e grave
+};
+
 void inicializar_buzzers() {
-    // Inicializa os pinos dos buzzers como saída
-    gpio_init(BUZZER_A);
-    gpio_init(BUZZER_B);
-    gpio_set_dir(BUZZER_A, GPIO_OUT);
-    gpio_set_dir(BUZZER_B, GPIO_OUT);
-    gpio_put(BUZZER_A, 0);
-    gpio_put(BUZZER_B, 0);
+    som_iniciar(BUZZER_A, BUZZER_B);
 }
 
 void tocar_som_pixel() {
-    // Toca um som curto e agudo no buzzer A
-    for (int i = 0; i < 100; i++) {
-        gpio_put(BUZZER_A, 1);
-        sleep_us(500);
-        gpio_put(BUZZER_A, 0);
-        sleep_us(500);
-    }
+    PERFIL_INICIO(PERFIL_SOM);
+    som_enfileirar(CANAL_BUZZER_A, som_pixel, sizeof(som_pixel) / sizeof(som_pixel[0]));
+    PERFIL_FIM();
 }
 
 void tocar_som_game_over() {
-    // Toca um som longo e grave no buzzer B
-    for (int i = 0; i < 500; i++) {
-        gpio_put(BUZZER_B, 1);
-        sleep_us(1000);
-        gpio_put(BUZZER_B, 0);
-        sleep_us(1000);
+    PERFIL_INICIO(PERFIL_SOM);
+    som_enfileirar(CANAL_BUZZER_B, som_game_over, sizeof(som_game_over) / sizeof(som_game_over[0]));
+    PERFIL_FIM();
+}
+
+// ─── Telemetria binária no USB (tools/telemetria_csv.py decodifica) ───────
+// Escreve só o que cabe na FIFO do CDC: o laço do jogo nunca espera o USB
+size_t escrever_usb(const uint8_t *bytes, size_t n) {
+    if (!tud_cdc_connected()) return n;  // Ninguém ouvindo: descarta
+    uint32_t livre = tud_cdc_write_available();
+    if (n > livre) n = livre;
+    if (n > 0) {
+        tud_cdc_write(bytes, (uint32_t)n);
+        tud_cdc_write_flush();
     }
+    return n;
+}
+
+static uint16_t saturar_u16(uint32_t valor) {
+    return valor > 0xFFFF ? 0xFFFF : (uint16_t)valor;
 }
 
-// ─── Função para imprimir o estado do jogo no monitor serial ────────────────
-void imprimir_estado_jogo() {
-    int valor_x = ler_adc(1);
-    int valor_y = ler_adc(0);
-    const char* estado_jogo = jogo_pausado ? "Pausado" : (fim_de_jogo ? "Game Over" : "Jogando");
-    printf("Joystick X: %d, Joystick Y: %d, Posição Jogador: (%d, %d), Estado: %s, Pontuação: %d, Vidas: %d\n",
-           valor_x, valor_y, posicao_jogador_x, posicao_jogador_y, estado_jogo, pontuacao, vidas);
+// Um registro por quadro apresentado; o que o USB não levou agora sai no próximo
+void publicar_telemetria() {
+    PERFIL_INICIO(PERFIL_TELEMETRIA);
+    uint16_t jogador = entidades_indice(&entidades, id_jogador), pixel = entidades_indice(&entidades, id_pixel);
+    uint8_t estado = (jogo_iniciado ? TELEMETRIA_ESTADO_INICIADO : 0) | (jogo_pausado ? TELEMETRIA_ESTADO_PAUSADO : 0) |
+                     (fim_de_jogo ? TELEMETRIA_ESTADO_FIM : 0) | (tempo_imune > 0 ? TELEMETRIA_ESTADO_IMUNE : 0);
+    telemetria_quadro_t quadro = {
+        .tempo_ms = to_ms_since_boot(get_absolute_time()),
+        .passos = agendador.passos,
+        .renders = agendador.renders,
+        .matriz_enviadas = matriz_atualizacoes_enviadas(),
+        .matriz_puladas = matriz_atualizacoes_puladas(),
+        .joystick_x = ultima_entrada_x,
+        .joystick_y = ultima_entrada_y,
+        .pontuacao = saturar_u16(pontuacao),
+        .renders_pulados = saturar_u16(agendador.renders_pulados),
+        .prazos_perdidos = saturar_u16(agendador.prazos_perdidos),
+        .jitter_medio_us = saturar_u16(agendador_jitter_medio_us(&agendador)),
+        .jitter_max_us = saturar_u16(agendador.jitter_max_us),
+        .jogador_x = (uint8_t)entidades.x[jogador],
+        .jogador_y = (uint8_t)entidades.y[jogador],
+        .pixel_x = (uint8_t)entidades.x[pixel],
+        .pixel_y = (uint8_t)entidades.y[pixel],
+        .vidas = (uint8_t)(vidas < 0 ? 0 : vidas),
+        .estado = estado,
+    };
+    telemetria_publicar(&telemetria, &quadro);
+#if ESPELHAR_TELA
+    espelho_publicar(&espelho, &display.ram_buffer[1], &telemetria);
+#endif
+    telemetria_drenar(&telemetria, escrever_usb);
+    PERFIL_FIM();
+}
+
+// ─── Reposiciona um pixel aleatoriamente, fora da área de pontos e do jogador ───
+void reposicionar_pixel(entidade_id_t id) {
+    uint16_t jogador = entidades_indice(&entidades, id_jogador), pixel = entidades_indice(&entidades, id);
+    retangulo_t area_jogador = { entidades.x[jogador], entidades.y[jogador], TAMANHO_JOGADOR, TAMANHO_JOGADOR };
+    posicionamento_excluir(&posicionamento_pixel, EXCLUSAO_JOGADOR, &area_jogador);
+    int x = entidades.x[pixel], y = entidades.y[pixel];
+    posicionamento_sortear(&posicionamento_pixel, &x, &y);
+    entidades.x[pixel] = (int16_t)x;
+    entidades.y[pixel] = (int16_t)y;
+}
+
+// ─── Um passo fixo da lógica do jogo ─────────────────────────────────────
+void passo_logica(uint32_t agora) {
+    PERFIL_INICIO(PERFIL_LOGICA);
+    uint16_t valor_x, valor_y;
+    PERFIL_INICIO(PERFIL_ENTRADA);
+    fonte_entrada(&valor_x, &valor_y);
+    ultima_entrada_x = valor_x;
+    ultima_entrada_y = valor_y;
+    PERFIL_FIM();
+#if GRAVAR_ENTRADAS
+    gravacao_passo(&gravacao, valor_x, valor_y);
+#endif
+
+    // Reseta imunidade após duração
+    if (tempo_imune > 0 && agora >= tempo_imune) {
+        tempo_imune = 0;
+    }
+
+    int dx = 0, dy = 0;
+    // Movimento no eixo X
+    if (valor_x > centro_x + ZONA_MORTA) dx = VELOCIDADE;
+    else if (valor_x < centro_x - ZONA_MORTA) dx = -VELOCIDADE;
+    // Movimento no eixo Y
+    if (valor_y > centro_y + ZONA_MORTA) dy = -VELOCIDADE;
+    else if (valor_y < centro_y - ZONA_MORTA) dy = VELOCIDADE;
+
+    uint16_t jogador = entidades_indice(&entidades, id_jogador);
+    int nova_posicao_x = entidades.x[jogador] + dx;
+    int nova_posicao_y = entidades.y[jogador] + dy;
+
+    // Verifica colisão com borda (sem imunidade)
+    if (tempo_imune == 0 && verificar_colisao_borda(nova_posicao_x, nova_posicao_y, TAMANHO_JOGADOR, TAMANHO_JOGADOR)) {
+        vidas--;
+        if (vidas <= 0) {
+            fim_de_jogo = true;
+            exibir_vidas(-1);
+            atualizar_leds();
+            tocar_som_game_over();
+            PERFIL_FIM();
+            return;
+        }
+        tempo_imune = agora + DURACAO_IMUNE_MS;
+    }
+
+    // Move o jogador se não houver colisão ou se estiver imune
+    if (!verificar_colisao_borda(nova_posicao_x, nova_posicao_y, TAMANHO_JOGADOR, TAMANHO_JOGADOR) || tempo_imune > 0) {
+        entidades.x[jogador] = (int16_t)nova_posicao_x;
+        entidades.y[jogador] = (int16_t)nova_posicao_y;
+    }
+
+    // Verifica se o jogador coletou algum pixel (a consulta também devolve o próprio jogador)
+    entidade_id_t tocadas[4];
+    grade_montar(&grade, &entidades);
+    uint16_t num_tocadas = grade_consultar(&grade, &entidades, entidades.x[jogador], entidades.y[jogador],
+                                           TAMANHO_JOGADOR, TAMANHO_JOGADOR, tocadas, 4);
+    for (uint16_t i = 0; i < num_tocadas; i++) {
+        if (entidades.tipo[entidades_indice(&entidades, tocadas[i])] != ENTIDADE_COLETAVEL) continue;
+        pontuacao++;
+        reposicionar_pixel(tocadas[i]);
+        tocar_som_pixel();
+    }
+    PERFIL_FIM();
+}
+
+// ─── Desenha um quadro do jogo ───────────────────────────────────────────
+void desenhar_quadro(uint32_t agora) {
+    PERFIL_INICIO(PERFIL_DESENHO);
+    ssd1306_t *sprites = &display;
+    if (camadas_ativas) {
+        if (!camadas_compostas) compositor_invalidate(&compositor);
+        desenhar_pontuacao();
+        sprites = compositor_layer(&compositor, CAMADA_SPRITES);
+        compositor_erase(&compositor, CAMADA_SPRITES);
+    } else {
+        framebuffer_128x64_fill(&display, false);
+    }
+    uint8_t quadro_jogador = (tempo_imune > 0) && (((agora / PISCA_IMUNE_MS) % 2) == 0);
+    uint8_t quadro_coletavel = (uint8_t)((agora / PASSO_COLETAVEL_MS) % 2);
+    for (uint16_t i = 0; i < entidades.quantidade; i++) {
+        if (entidades.tipo[i] == ENTIDADE_JOGADOR) {
+            sprite_draw(sprites, &sprite_jogador, quadro_jogador, entidades.x[i], entidades.y[i]);
+        } else if (entidades.tipo[i] == ENTIDADE_COLETAVEL) {
+            sprite_draw(sprites, &sprite_coletavel, quadro_coletavel, entidades.x[i], entidades.y[i]);
+        } else {
+            framebuffer_128x64_fill_rect(sprites, entidades.x[i], entidades.y[i], entidades.largura[i], entidades.altura[i], true);
+        }
+    }
+    if (camadas_ativas) {
+        palavras_compostas += compositor_compose(&compositor);
+        camadas_compostas = true;
+    } else {
+        // Borda e pontuação por cima, como na composição, mas o texto é opaco: onde ele cruza
+        // um sprite, o fundo das letras apaga o que o OU das camadas mostraria
+        desenhar_borda(&display, 0, 0, LARGURA_TELA, ALTURA_TELA, BORDAS);
+        desenhar_pontuacao();
+    }
+    desenhar_vidas();
+#if GRAVAR_ENTRADAS
+    gravacao_quadro(&gravacao, gravacao_hash(&display.ram_buffer[1], display.bufsize - 1));
+#endif
+    efeitos_pedidos = EFEITOS_NORMAIS;
+    apresentar_quadro();
+    tela_mostrada = TELA_JOGO;
+    PERFIL_FIM();
+}
+
+// ─── Estado inicial de uma partida; a semente define onde os pixels nascem ───
+void preparar_partida(uint32_t semente) {
+    entidades_iniciar(&entidades);
+    id_jogador = entidades_criar(&entidades, ENTIDADE_JOGADOR, (LARGURA_TELA - TAMANHO_JOGADOR) / 2,
+                                 (ALTURA_TELA - TAMANHO_JOGADOR) / 2, TAMANHO_JOGADOR, TAMANHO_JOGADOR);
+    id_pixel = entidades_criar(&entidades, ENTIDADE_COLETAVEL, BORDAS, BORDAS, TAMANHO_PIXEL, TAMANHO_PIXEL);
+    pontuacao = 0;
+    vidas = MAX_VIDAS;
+    fim_de_jogo = false;
+    jogo_pausado = false;
+    tempo_imune = 0;
+
+    atualizar_leds();
+    aleatorio_semear(semente);
+    retangulo_t campo = { BORDAS, BORDAS, LARGURA_TELA - 2 * BORDAS, ALTURA_TELA - 2 * BORDAS };
+    retangulo_t area_pontos = { AREA_PONTOS_X, AREA_PONTOS_Y, AREA_PONTOS_LARGURA, AREA_PONTOS_ALTURA };
+    posicionamento_iniciar(&posicionamento_pixel, &campo, TAMANHO_PIXEL, TAMANHO_PIXEL);
+    posicionamento_excluir(&posicionamento_pixel, EXCLUSAO_PONTOS, &area_pontos);
+    reposicionar_pixel(id_pixel);
 }
 
 // ─── Inicia o jogo após START ───────────────────────────────────────────
@@ -306,10 +734,12 @@ void iniciar_jogo() {
     uint32_t inicio = to_ms_since_boot(get_absolute_time());
     int soma_x = 0, soma_y = 0, contador = 0;
 
-    // Calibração inicial do joystick
+    // Calibração inicial do joystick (cada leitura já é uma média do amostrador)
     while (to_ms_since_boot(get_absolute_time()) - inicio < TEMPO_CALIBRAGEM_MS) {
-        soma_x += ler_adc(1);
-        soma_y += ler_adc(0);
+        uint16_t valor_x, valor_y;
+        joystick_ler(&valor_x, &valor_y);
+        soma_x += valor_x;
+        soma_y += valor_y;
         contador++;
         sleep_ms(5);
     }
@@ -318,129 +748,54 @@ void iniciar_jogo() {
     centro_x = soma_x / contador;
     centro_y = soma_y / contador;
 
-    posicao_jogador_x = (LARGURA_TELA - TAMANHO_JOGADOR) / 2;
-    posicao_jogador_y = (ALTURA_TELA - TAMANHO_JOGADOR) / 2;
-    pontuacao = 0;
-    vidas = MAX_VIDAS;
-    fim_de_jogo = false;
-    jogo_pausado = false;
-
-    atualizar_leds();
-
-    int area_pontos_x = 2;
-    int area_pontos_y = 2;
-    int area_pontos_largura = 50;
-    int area_pontos_altura = 10;
+    // O instante exato do START (em us) varia a cada partida
+    uint32_t semente = (uint32_t)time_us_64() ^ ((uint32_t)soma_x << 16) ^ (uint32_t)soma_y;
+    preparar_partida(semente);
+#if GRAVAR_ENTRADAS
+    gravacao_cabecalho_t cabecalho = { semente, PASSO_LOGICA_US, (uint16_t)centro_x, (uint16_t)centro_y };
+    gravacao_iniciar(&gravacao, enviar_gravacao, &cabecalho);
+#endif
 
-    // Posiciona o pixel aleatoriamente, evitando a área de pontos
-    posicao_pixel_x = BORDAS + rand() % (LARGURA_TELA - 2 * BORDAS - TAMANHO_PIXEL);
-    posicao_pixel_y = BORDAS + rand() % (ALTURA_TELA - 2 * BORDAS - TAMANHO_PIXEL);
-
-    while (verificar_colisao(posicao_pixel_x, posicao_pixel_y, TAMANHO_PIXEL, TAMANHO_PIXEL, area_pontos_x, area_pontos_y, area_pontos_largura, area_pontos_altura)) {
-        posicao_pixel_x = BORDAS + rand() % (LARGURA_TELA - 2 * BORDAS - TAMANHO_PIXEL);
-        posicao_pixel_y = BORDAS + rand() % (ALTURA_TELA - 2 * BORDAS - TAMANHO_PIXEL);
-    }
-
-    uint32_t tempo_imune = 0;
-    const uint32_t duracao_imune = 1500;
-    bool pisca_jogador = false;
-    uint32_t ultimo_impressao_ms = 0;
+    // Lógica em passo fixo contra prazos de time_us_64; o desenho acompanha quando há folga
+    agendador_iniciar(&agendador, time_us_64, PASSO_LOGICA_US, PERIODO_RENDER_US);
 
     while (!fim_de_jogo) {
-        uint32_t agora = to_ms_since_boot(get_absolute_time());
-
+        PERFIL_ATENDER();
+        atender_botoes();
         if (jogo_pausado) {
-            tela_pausa();
-            sleep_ms(50);
+            uint64_t prazo = tela_pausa();
+            publicar_telemetria();
+            dormir_ate(prazo);
+            agendador_sincronizar(&agendador);
             continue;
         }
 
-        if (agora - ultimo_impressao_ms >= 1000) {
-            imprimir_estado_jogo();
-            ultimo_impressao_ms = agora;
+        bool houve_passo = false;
+        agendador_atualizar(&agendador);
+        while (!fim_de_jogo && agendador_consumir_passo(&agendador)) {
+            passo_logica(agendador_tempo_logico_ms(&agendador));
+            houve_passo = true;
         }
+        if (fim_de_jogo) break;
 
-        int valor_x = ler_adc(1);
-        int valor_y = ler_adc(0);
-
-        // Reseta imunidade após duração
-        if (tempo_imune > 0 && agora >= tempo_imune) {
-            tempo_imune = 0;
-        }
-
-        int dx = 0, dy = 0;
-        // Movimento no eixo X
-        if (valor_x > centro_x + ZONA_MORTA) dx = VELOCIDADE;
-        else if (valor_x < centro_x - ZONA_MORTA) dx = -VELOCIDADE;
-        // Movimento no eixo Y
-        if (valor_y > centro_y + ZONA_MORTA) dy = -VELOCIDADE;
-        else if (valor_y < centro_y - ZONA_MORTA) dy = VELOCIDADE;
-
-        int nova_posicao_x = posicao_jogador_x + dx;
-        int nova_posicao_y = posicao_jogador_y + dy;
-
-        // Verifica colisão com borda (sem imunidade)
-        if (tempo_imune == 0 && verificar_colisao_borda(nova_posicao_x, nova_posicao_y, TAMANHO_JOGADOR, TAMANHO_JOGADOR)) {
-            vidas--;
-            if (vidas <= 0) {
-                fim_de_jogo = true;
-                desligar_matriz();
-                atualizar_leds();
-                tocar_som_game_over();
-                break;
-            }
-            tempo_imune = agora + duracao_imune;
+        if (houve_passo && agendador_deve_renderizar(&agendador)) {
+            desenhar_quadro(agendador_tempo_logico_ms(&agendador));
+            publicar_telemetria();
         }
-
-        // Move o jogador se não houver colisão ou se estiver imune
-        if (!verificar_colisao_borda(nova_posicao_x, nova_posicao_y, TAMANHO_JOGADOR, TAMANHO_JOGADOR) || tempo_imune > 0) {
-            posicao_jogador_x = nova_posicao_x;
-            posicao_jogador_y = nova_posicao_y;
-        }
-
-        // Verifica se o jogador coletou o pixel
-        if (verificar_colisao(posicao_jogador_x, posicao_jogador_y, TAMANHO_JOGADOR, TAMANHO_JOGADOR,
-                              posicao_pixel_x, posicao_pixel_y, TAMANHO_PIXEL, TAMANHO_PIXEL)) {
-            pontuacao++;
-            // Reposiciona o pixel aleatoriamente, evitando a área de pontos
-            posicao_pixel_x = BORDAS + rand() % (LARGURA_TELA - 2 * BORDAS - TAMANHO_PIXEL);
-            posicao_pixel_y = BORDAS + rand() % (ALTURA_TELA - 2 * BORDAS - TAMANHO_PIXEL);
-
-            while (verificar_colisao(posicao_pixel_x, posicao_pixel_y, TAMANHO_PIXEL, TAMANHO_PIXEL, area_pontos_x, area_pontos_y, area_pontos_largura, area_pontos_altura)) {
-                posicao_pixel_x = BORDAS + rand() % (LARGURA_TELA - 2 * BORDAS - TAMANHO_PIXEL);
-                posicao_pixel_y = BORDAS + rand() % (ALTURA_TELA - 2 * BORDAS - TAMANHO_PIXEL);
-            }
-
-            tocar_som_pixel();
-        }
-
-        ssd1306_fill(&display, false);
-        desenhar_borda(&display, 0, 0, LARGURA_TELA, ALTURA_TELA, BORDAS);
-        pisca_jogador = (tempo_imune > 0) && (((agora / 150) % 2) == 0);
-        if (!pisca_jogador) desenhar_retangulo(&display, posicao_jogador_x, posicao_jogador_y, TAMANHO_JOGADOR, TAMANHO_JOGADOR);
-        desenhar_retangulo(&display, posicao_pixel_x, posicao_pixel_y, TAMANHO_PIXEL, TAMANHO_PIXEL);
-        desenhar_pontuacao();
-        desenhar_vidas();
-        ssd1306_send_data(&display);
-
-        sleep_ms(30);
+        PERFIL_INICIO(PERFIL_OCIOSO);
+        agendador_dormir(&agendador);
+        PERFIL_FIM();
     }
+#if GRAVAR_ENTRADAS
+    gravacao_encerrar(&gravacao, pontuacao, vidas);
+#endif
 
     while (fim_de_jogo) {
-        tela_game_over();
-        mostrar_numero_vidas(0);
-        sleep_ms(50);
-
-        // Verifica manualmente o botão B se a interrupção não estiver funcionando
-        if (gpio_get(PINO_BOTAO) == 0) {
-            uint32_t agora_ms = to_ms_since_boot(get_absolute_time());
-            if (agora_ms - ultimo_pulso_ms > 200) {
-                ultimo_pulso_ms = agora_ms;
-                fim_de_jogo = false;
-                jogo_iniciado = true;
-                atualizar_leds();
-            }
-        }
+        PERFIL_ATENDER();
+        uint64_t prazo = tela_game_over();
+        publicar_telemetria();
+        dormir_ate(prazo);
+        atender_botoes();
     }
 }
 
@@ -451,33 +806,35 @@ int main() {
     gpio_set_function(I2C_SCL_PIN, GPIO_FUNC_I2C);
     gpio_pull_up(I2C_SDA_PIN);
     gpio_pull_up(I2C_SCL_PIN);
-    adc_init();
-    adc_gpio_init(PINO_JOYSTICK_X);
-    adc_gpio_init(PINO_JOYSTICK_Y);
+    joystick_iniciar(PINO_JOYSTICK_X, PINO_JOYSTICK_Y);
     ssd1306_init(&display, LARGURA_TELA, ALTURA_TELA, false, ENDERECO_OLED, I2C_PORT);
-    ssd1306_config(&display);
+    iniciar_camadas();
     inicializar_matriz_led();
+#if RENDER_NUCLEO1
+    ssd1306_init(&painel, LARGURA_TELA, ALTURA_TELA, false, ENDERECO_OLED, I2C_PORT);
+    configurar_oled(&painel);
+    anel_quadros_iniciar(&anel_quadros);
+    multicore_launch_core1(nucleo1_principal);
+#else
+    configurar_oled(&display);
+    ssd1306_init_dma(&display); // Sem canal livre o envio continua bloqueante
+#endif
 
     inicializar_leds();
     inicializar_buzzers();
     inicializar_botoes();
+    telemetria_iniciar(&telemetria);
+#if ESPELHAR_TELA
+    espelho_iniciar(&espelho);
+#endif
 
     while (!jogo_iniciado) {
-        tela_inicial();
-        mostrar_numero_vidas(MAX_VIDAS);
+        PERFIL_ATENDER();
+        uint64_t prazo = tela_inicial();
+        publicar_telemetria();
         atualizar_leds();
-
-        // Verifica manualmente o botão B se a interrupção não estiver funcionando
-        if (gpio_get(PINO_BOTAO) == 0) {
-            uint32_t agora_ms = to_ms_since_boot(get_absolute_time());
-            if (agora_ms - ultimo_pulso_ms > 200) {
-                ultimo_pulso_ms = agora_ms;
-                jogo_iniciado = true;
-                atualizar_leds();
-            }
-        }
-
-        sleep_ms(30);
+        dormir_ate(prazo);
+        atender_botoes();
     }
 
     while (1) iniciar_jogo();
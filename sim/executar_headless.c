@@ -0,0 +1,310 @@
+// Executor headless: roda o jogo na HAL simulada com um piloto automático que
+// inicia as partidas e persegue o pixel, e relata quanto cada quadro custaria no dispositivo.
+//
+//   Coletor_Pixels_host [-s segundos_virtuais] [-v] [-t telemetria.bin] [-r] [-e segundos_na_tela] [-k]
+//
+// -v mantém a saída serial do jogo; por padrão ela é descartada e só o relatório aparece.
+// -t grava o fluxo de telemetria do CDC USB, para tools/telemetria_csv.py (e, com
+//    ESPELHAR_TELA, para tools/espelho_tela.py).
+// -r aperta o botão com ressalto no contato e na soltura, com a IRQ atendida tarde o bastante
+//    para juntar bordas numa máscara só, e sai com 1 se algum aperto não virar exatamente um
+//    evento na fila de botões.
+// -e é quanto o piloto fica na abertura e no game over antes de apertar B (padrão 0,3 s).
+// -k simula um OLED que não aguenta Fast-mode Plus (NAK acima de 400 kHz), para ver a volta
+//    do I2C_FM_PLUS para 400 kHz.
+// Com PERFILAR_QUADROS o perfil por etapa vem no fim, em us virtuais: só as esperas de
+// barramento aparecem, o tempo de CPU de cada etapa é zero na HAL simulada.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "sim.h"
+#include "agendador.h"
+#include "perfil.h"
+#include "entidades.h"
+#include "botoes.h"
+#include "espelho.h"
+#include "ssd1306.h"
+
+#define CANAL_ADC_X          1        // GPIO 27
+#define CANAL_ADC_Y          0        // GPIO 26
+#define PINO_BOTAO_B         6
+#define CENTRO_ADC           2048
+#define DESVIO_ADC           1000     // Bem além da zona morta do jogo
+#define MEIO_JOGADOR         4
+#define MEIO_PIXEL           2
+#define APERTO_BOTAO_US      50000
+#define INTERVALO_BOTAO_US   300000
+#define RESSALTOS_MAX        4        // Pares de bordas extras em cada transição
+#define RESSALTO_MAX_US      700      // Distância máxima entre bordas do ressalto
+#define LATENCIA_IRQ_US      300      // Com -r: bordas mais próximas que isto chegam juntas à IRQ
+#define CALIBRAGEM_US        2500000  // Joystick parado enquanto o jogo calibra
+#define SEGUNDOS_PADRAO      60
+#define TAXA_MAX_SEM_FM_PLUS 400000
+
+int jogo_main(void);
+extern bool jogo_iniciado;
+extern bool fim_de_jogo;
+extern entidades_t entidades;
+extern entidade_id_t id_jogador, id_pixel;
+extern int pontuacao;
+extern agendador_t agendador;
+extern botoes_t botoes;
+extern uint32_t telas_desenhadas, despertares_ociosos;
+extern uint32_t palavras_compostas, redesenhos_hud;
+extern ssd1306_t display;
+extern uint32_t oled_config_us;
+#if ESPELHAR_TELA
+extern espelho_t espelho;
+#endif
+
+// Só o tempo de partida (sem calibragem, abertura ou game over) entra nas médias por quadro;
+// abertura e game over vão para em_telas, que mostra quanto as telas paradas ainda custam
+typedef struct {
+    uint64_t tempo_us;
+    uint64_t ocupado_us;
+    uint64_t dormindo_us;
+    uint64_t i2c_bytes;
+    uint64_t i2c_barramento_us;
+    uint32_t i2c_transacoes;
+    uint32_t matriz_quadros;
+    uint32_t despertares;
+} fatia_t;
+
+static uint64_t aperto_us;             // Instante do último aperto agendado (0: nenhum)
+static bool aperto_contado;
+static uint64_t calibrando_ate_us;
+static bool estava_em_fim;
+static uint32_t partidas;
+static uint32_t pontos_totais;
+static fatia_t em_jogo, em_telas;
+static uint64_t intervalo_botao_us = INTERVALO_BOTAO_US;
+static sim_estatisticas_t anteriores;
+static uint64_t anterior_us;
+static uint32_t quadros_partidas_anteriores, quadros_ultima_leitura;
+static FILE *arquivo_telemetria;
+static bool com_ressalto;
+static uint32_t apertos;
+static uint32_t sorteio_ressalto = 0x9E3779B9u;  // Gerador próprio: o do jogo precisa ficar intocado
+
+static uint32_t sortear_ressalto(uint32_t limite) {
+    sorteio_ressalto ^= sorteio_ressalto << 13;
+    sorteio_ressalto ^= sorteio_ressalto >> 17;
+    sorteio_ressalto ^= sorteio_ressalto << 5;
+    return sorteio_ressalto % limite;
+}
+
+// Contato que vai e volta algumas vezes antes de assentar, tanto ao apertar quanto ao soltar
+static void pressionar_com_ressalto(unsigned int gpio, uint64_t atraso_us, uint64_t duracao_us) {
+    for (int soltura = 0; soltura < 2; soltura++) {
+        uint64_t t = atraso_us + (soltura ? duracao_us : 0);
+        bool pressionado = !soltura;
+        sim_borda(gpio, t, pressionado);
+        for (uint32_t i = sortear_ressalto(RESSALTOS_MAX + 1); i > 0; i--) {
+            t += 1 + sortear_ressalto(RESSALTO_MAX_US);
+            sim_borda(gpio, t, !pressionado);
+            t += 1 + sortear_ressalto(RESSALTO_MAX_US);
+            sim_borda(gpio, t, pressionado);
+        }
+    }
+}
+
+// fatia NULL (calibragem) só avança as leituras anteriores
+static void contabilizar(uint64_t agora_us, fatia_t *fatia) {
+    const sim_estatisticas_t *e = sim_estatisticas();
+    if (fatia) {
+        fatia->tempo_us += agora_us - anterior_us;
+        fatia->ocupado_us += e->tempo_ocupado_us - anteriores.tempo_ocupado_us;
+        fatia->dormindo_us += e->tempo_dormindo_us - anteriores.tempo_dormindo_us;
+        fatia->i2c_bytes += e->i2c_bytes - anteriores.i2c_bytes;
+        fatia->i2c_barramento_us += e->i2c_barramento_us - anteriores.i2c_barramento_us;
+        fatia->i2c_transacoes += e->i2c_transacoes - anteriores.i2c_transacoes;
+        fatia->matriz_quadros += e->matriz_quadros - anteriores.matriz_quadros;
+        fatia->despertares += e->despertares - anteriores.despertares;
+    }
+    anteriores = *e;
+    anterior_us = agora_us;
+
+    // O agendador recomeça a cada partida
+    if (agendador.renders < quadros_ultima_leitura) quadros_partidas_anteriores += quadros_ultima_leitura;
+    quadros_ultima_leitura = agendador.renders;
+}
+
+static uint16_t eixo(int distancia) {
+    if (distancia > 1) return CENTRO_ADC + DESVIO_ADC;
+    if (distancia < -1) return CENTRO_ADC - DESVIO_ADC;
+    return CENTRO_ADC;
+}
+
+// O aperto vai agendado no relógio: com o jogo parado em __wfi o gancho só roda quando algo
+// acorda o núcleo, e um aperto decidido aqui esperaria o próximo despertar
+static void agendar_aperto(uint64_t agora_us, uint64_t atraso_us) {
+    if (com_ressalto) {
+        pressionar_com_ressalto(PINO_BOTAO_B, atraso_us, APERTO_BOTAO_US);
+    } else {
+        sim_borda(PINO_BOTAO_B, atraso_us, true);
+        sim_borda(PINO_BOTAO_B, atraso_us + APERTO_BOTAO_US, false);
+    }
+    aperto_us = agora_us + atraso_us;
+    aperto_contado = false;
+}
+
+static void piloto_automatico(uint64_t agora_us) {
+    bool em_tela = !jogo_iniciado || fim_de_jogo;
+    contabilizar(agora_us, em_tela ? &em_telas : agora_us >= calibrando_ate_us ? &em_jogo : NULL);
+    if (fim_de_jogo && !estava_em_fim) {
+        partidas++;
+        pontos_totais += (uint32_t)pontuacao;
+    }
+    estava_em_fim = fim_de_jogo;
+
+    // O gancho roda antes das IRQs do mesmo instante, então o aperto conta antes de chegar ao jogo
+    if (aperto_us && !aperto_contado && agora_us >= aperto_us) {
+        apertos++;
+        aperto_contado = true;
+        calibrando_ate_us = aperto_us + CALIBRAGEM_US;
+    }
+
+    if (em_tela) {
+        sim_definir_adc(CANAL_ADC_X, CENTRO_ADC);
+        sim_definir_adc(CANAL_ADC_Y, CENTRO_ADC);
+        // Um aperto a cada intervalo enquanto a tela não sai
+        if (!aperto_us || agora_us >= aperto_us + intervalo_botao_us) agendar_aperto(agora_us, intervalo_botao_us);
+        return;
+    }
+    aperto_us = 0;
+    if (agora_us < calibrando_ate_us) return;
+
+    // Y do joystick é invertido em relação à tela
+    uint16_t jogador = entidades_indice(&entidades, id_jogador), pixel = entidades_indice(&entidades, id_pixel);
+    int dx = (entidades.x[pixel] + MEIO_PIXEL) - (entidades.x[jogador] + MEIO_JOGADOR);
+    int dy = (entidades.y[pixel] + MEIO_PIXEL) - (entidades.y[jogador] + MEIO_JOGADOR);
+    sim_definir_adc(CANAL_ADC_X, eixo(dx));
+    sim_definir_adc(CANAL_ADC_Y, eixo(-dy));
+}
+
+static void gravar_telemetria(const uint8_t *bytes, size_t n) {
+    fwrite(bytes, 1, n, arquivo_telemetria);
+}
+
+static double segundos_reais(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec / 1e9;
+}
+
+int main(int argc, char **argv) {
+    double segundos = SEGUNDOS_PADRAO;
+    bool verboso = false;
+    bool sem_fm_plus = false;
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-s") && i + 1 < argc) segundos = atof(argv[++i]);
+        else if (!strcmp(argv[i], "-v")) verboso = true;
+        else if (!strcmp(argv[i], "-r")) com_ressalto = true;
+        else if (!strcmp(argv[i], "-k")) sem_fm_plus = true;
+        else if (!strcmp(argv[i], "-e") && i + 1 < argc) intervalo_botao_us = (uint64_t)(atof(argv[++i]) * 1e6);
+        else if (!strcmp(argv[i], "-t") && i + 1 < argc) {
+            arquivo_telemetria = fopen(argv[++i], "wb");
+            if (!arquivo_telemetria) {
+                perror(argv[i]);
+                return 2;
+            }
+        } else {
+            fprintf(stderr, "uso: %s [-s segundos_virtuais] [-v] [-t telemetria.bin] [-r] [-e segundos_na_tela] [-k]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    int saida_real = -1;
+    if (!verboso) {
+        fflush(stdout);
+        saida_real = dup(STDOUT_FILENO);
+        int nulo = open("/dev/null", O_WRONLY);
+        dup2(nulo, STDOUT_FILENO);
+        close(nulo);
+    }
+
+    sim_reiniciar();
+    sim_definir_gancho(piloto_automatico);
+    if (sem_fm_plus) sim_limitar_i2c_oled(TAXA_MAX_SEM_FM_PLUS);
+    if (com_ressalto) sim_latencia_irq_gpio(LATENCIA_IRQ_US);
+    if (arquivo_telemetria) sim_definir_usb(gravar_telemetria);
+    double inicio = segundos_reais();
+    uint64_t fim_us = sim_executar(jogo_main, (uint64_t)(segundos * 1e6));
+    double duracao = segundos_reais() - inicio;
+    if (arquivo_telemetria) fclose(arquivo_telemetria);
+
+    if (saida_real >= 0) {
+        fflush(stdout);
+        dup2(saida_real, STDOUT_FILENO);
+        close(saida_real);
+    }
+
+    const sim_estatisticas_t *e = sim_estatisticas();
+    uint32_t quadros = quadros_partidas_anteriores + agendador.renders;
+    double por_quadro = quadros ? 1.0 / quadros : 0.0;
+    printf("Tempo virtual: %.3f s em %.3f s reais (%.0fx), %.3f s jogando\n",
+           fim_us / 1e6, duracao, duracao > 0 ? fim_us / 1e6 / duracao : 0.0, em_jogo.tempo_us / 1e6);
+    printf("Quadros desenhados: %lu (%.0f por segundo real); última partida: %lu passos, %lu pulados, %lu prazos perdidos\n",
+           (unsigned long)quadros, duracao > 0 ? quadros / duracao : 0.0, (unsigned long)agendador.passos,
+           (unsigned long)agendador.renders_pulados, (unsigned long)agendador.prazos_perdidos);
+    printf("Partidas encerradas: %lu, pontuação média: %.1f, pontuação atual: %d\n",
+           (unsigned long)partidas, partidas ? (double)pontos_totais / partidas : 0.0, pontuacao);
+    printf("I2C total: %llu bytes em %lu transações, %llu us de barramento\n",
+           (unsigned long long)e->i2c_bytes, (unsigned long)e->i2c_transacoes,
+           (unsigned long long)e->i2c_barramento_us);
+    printf("Por quadro em jogo: %.1f bytes I2C em %.1f transações, %.0f us de barramento, %.0f us de CPU bloqueada "
+           "(estimativa no dispositivo)\n",
+           em_jogo.i2c_bytes * por_quadro, em_jogo.i2c_transacoes * por_quadro, em_jogo.i2c_barramento_us * por_quadro,
+           em_jogo.ocupado_us * por_quadro);
+    printf("Composição: %.1f palavras de 32 bits por quadro (a tela tem %u), HUD redesenhado %lu vezes\n",
+           palavras_compostas * por_quadro, display.bufsize / 4, (unsigned long)redesenhos_hud);
+    printf("OLED: configurado em %lu us, I2C a %u Hz no fim, %lu erros de barramento\n",
+           (unsigned long)oled_config_us, display.i2c_port->baudrate, (unsigned long)display.bus_errors);
+    double segundos_telas = em_telas.tempo_us / 1e6;
+    if (segundos_telas > 0) {
+        printf("Abertura e game over (%.1f s): %.0f bytes I2C/s em %.1f transações/s, %.2f quadros da matriz/s, "
+               "%.1f despertares/s, %.1f%% dormindo\n",
+               segundos_telas, em_telas.i2c_bytes / segundos_telas, em_telas.i2c_transacoes / segundos_telas,
+               em_telas.matriz_quadros / segundos_telas, em_telas.despertares / segundos_telas,
+               100.0 * em_telas.dormindo_us / em_telas.tempo_us);
+        printf("Telas retidas: %lu redesenhos (%.2f/s), %lu despertares do __wfi sem prazo nem botão\n",
+               (unsigned long)telas_desenhadas, telas_desenhadas / segundos_telas, (unsigned long)despertares_ociosos);
+    }
+    const sim_oled_t *oled = sim_oled();
+    printf("OLED no fim: contraste 0x%02X, %s, rolagem %s; %lu bytes escritos com a rolagem ligada\n",
+           oled->contraste, oled->invertido ? "invertido" : "normal", oled->rolagem_ativa ? "ligada" : "parada",
+           (unsigned long)oled->dados_rolando);
+    printf("Matriz LED: %lu quadros; alarmes: %lu; IRQs de GPIO: %lu; USB: %llu bytes\n",
+           (unsigned long)e->matriz_quadros, (unsigned long)e->alarmes_disparados, (unsigned long)e->irqs_gpio,
+           (unsigned long long)e->usb_bytes);
+    printf("Botões: %lu apertos, %lu eventos, %lu bordas, %lu ressaltos recusados, %lu descartados\n",
+           (unsigned long)apertos, (unsigned long)botoes.produzidos, (unsigned long)botoes.bordas,
+           (unsigned long)botoes.ressaltos, (unsigned long)botoes.descartados);
+#if ESPELHAR_TELA
+    printf("Espelho: %lu telas, %.1f bytes de carga por tela, %lu adiadas pelo orçamento, %lu descartadas\n",
+           (unsigned long)espelho.quadros, espelho.quadros ? (double)espelho.bytes / espelho.quadros : 0.0,
+           (unsigned long)espelho.adiados, (unsigned long)espelho.descartados);
+#endif
+#if PERFILAR_QUADROS
+    perfil_imprimir();
+#endif
+    if (oled->dados_rolando) {
+        fprintf(stderr, "rolagem: %lu bytes escritos na GDDRAM com a rolagem ligada\n",
+                (unsigned long)oled->dados_rolando);
+        return 1;
+    }
+    if (e->dma_origem_alterada) {
+        fprintf(stderr, "dma: %lu bytes mudados na origem de uma transferência em andamento\n",
+                (unsigned long)e->dma_origem_alterada);
+        return 1;
+    }
+    if (com_ressalto && botoes.produzidos != apertos) {
+        fprintf(stderr, "ressalto: %lu apertos viraram %lu eventos\n", (unsigned long)apertos,
+                (unsigned long)botoes.produzidos);
+        return 1;
+    }
+    return 0;
+}
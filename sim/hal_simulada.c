@@ -0,0 +1,1098 @@
+// HAL simulada do RP2040 para rodar o jogo no host.
+// Um relógio virtual substitui o timer: dormir, esperar barramento e girar em tight_loop_contents
+// só avançam esse relógio, e é nesse avanço que alarmes, IRQs de GPIO, conversões do ADC e o fim
+// das transferências de DMA acontecem. Os tempos de fio (I2C no clock configurado, WS2812 a
+// 800 kHz) seguem o hardware, então as estatísticas estimam o custo real no dispositivo.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <setjmp.h>
+#include "pico/stdlib.h"
+#include "pico/multicore.h"
+#include "hardware/gpio.h"
+#include "hardware/i2c.h"
+#include "hardware/adc.h"
+#include "hardware/pwm.h"
+#include "hardware/pio.h"
+#include "hardware/dma.h"
+#include "hardware/clocks.h"
+#include "hardware/sync.h"
+#include "tusb.h"
+#include "sim.h"
+
+#define MAX_ALARMES 16
+#define MAX_BORDAS 64
+#define OLED_ENDERECO 0x3C
+#define I2C_FIFO_BYTES 16
+#define PIO_FIFO_PALAVRAS 8          // FIFO TX unida da máquina de estados
+#define WS2812_US_POR_PIXEL 30       // 24 bits a 800 kHz
+#define WS2812_RESET_US 50
+#define ADC_CLOCK_HZ 48000000u
+#define ADC_CICLOS_MIN 96u
+#define ADC_CONVERSAO_US 2
+#define CLOCK_SISTEMA_HZ 125000000u
+#define DREQ_PIO0_TX0 0
+#define DREQ_I2C0_TX 32
+#define USB_BYTES_POR_QUADRO 64      // Um pacote bulk de full speed por quadro de 1 ms
+#define USB_QUADRO_US 1000
+#define DMA_COPIA_BYTES 4096         // Origem conferida no fim da transferência (quadro inteiro do OLED)
+#define PWM_SLICES 8
+
+typedef enum { TEMPO_DORMINDO, TEMPO_OCUPADO } tipo_tempo_t;
+
+// ─── Relógio virtual ──────────────────────────────────────────────────────
+static uint64_t agora_us;
+static uint64_t limite_us;
+static bool executando;
+static jmp_buf saida;
+static sim_gancho_t gancho;
+static sim_estatisticas_t estatisticas;
+static bool interrupcoes_desligadas;
+static bool em_interrupcao;
+
+// ─── Estado dos periféricos ───────────────────────────────────────────────
+static struct {
+    bool saida;
+    bool nivel_saida;
+    bool pull_up;
+    bool pressionado;
+    uint32_t eventos_irq;
+    uint32_t eventos_travados;   // Bordas esperando o atendimento da IRQ
+    uint64_t atendimento_em;
+} pinos[NUM_BANK0_GPIOS];
+static gpio_irq_callback_t callback_gpio;
+static uint64_t latencia_irq_gpio_us;   // 0: cada borda é atendida na hora, sozinha
+
+static struct {
+    bool usada;
+    uint64_t quando;
+    uint8_t gpio;
+    bool pressionado;
+} bordas[MAX_BORDAS];
+
+static struct {
+    bool ativo;
+    alarm_id_t id;
+    uint64_t alvo;
+    alarm_callback_t callback;
+    void *dados;
+} alarmes[MAX_ALARMES];
+static alarm_id_t proximo_id_alarme = 1;
+
+static i2c_hw_t i2c_hw_sim[2];
+i2c_inst_t i2c0_inst = { &i2c_hw_sim[0], 0 };
+i2c_inst_t i2c1_inst = { &i2c_hw_sim[1], 0 };
+static uint64_t i2c_livre_em[2];
+static bool i2c_stop_pendente[2];
+static unsigned int i2c_taxa_max_oled;  // Acima disto o OLED não responde (0 = qualquer taxa)
+
+adc_hw_t sim_adc_hw;
+static const uint16_t ADC_PADRAO[5] = { 2048, 2048, 2048, 2048, 876 };
+static uint16_t adc_valores[5] = { 2048, 2048, 2048, 2048, 876 };
+static uint adc_canal;
+static uint adc_mascara_rr;
+static bool adc_rodando, adc_dreq;
+static float adc_divisor;
+static uint64_t adc_proxima_ns;
+
+static uint16_t pwm_niveis[PWM_SLICES][2];
+static uint16_t pwm_topos[PWM_SLICES];
+
+pio_hw_t sim_pio_hw[2];
+static uint64_t pio_livre_em;
+static uint32_t matriz_recebendo[SIM_MATRIZ_PIXELS];
+static uint32_t matriz_exibida[SIM_MATRIZ_PIXELS];
+static uint matriz_indice;
+
+typedef struct {
+    bool reservado;
+    dma_channel_config cfg;
+    volatile void *escrita;
+    const volatile void *leitura;
+    uint32_t contagem;
+    uint64_t fim_us;
+    bool fluxo_adc;
+    uint32_t indice;
+    // O hardware lê a origem aos poucos durante a transferência, e a simulação lê tudo no disparo:
+    // a cópia guardada no disparo é comparada com a origem no fim para pegar quem a mudou no meio
+    bool conferir_origem;
+    uint32_t bytes_origem;
+    uint8_t copia_origem[DMA_COPIA_BYTES];
+} canal_dma_sim_t;
+static canal_dma_sim_t canais_dma[NUM_DMA_CHANNELS];
+
+static uint32_t usb_fifo_bytes;
+static uint64_t usb_drenado_em;
+static sim_usb_saida_t saida_usb;
+
+static sim_oled_t oled;
+static struct {
+    uint8_t comando, faltam, n;
+    uint8_t args[6];
+    uint8_t col_ini, col_fim, pag_ini, pag_fim, col, pag;
+} ctrl_oled;
+
+static void processar_eventos(void);
+
+// ─── Avanço do tempo ──────────────────────────────────────────────────────
+static uint64_t proximo_evento(void) {
+    uint64_t proximo = UINT64_MAX;
+    for (int i = 0; i < 2; i++) {
+        if (i2c_stop_pendente[i] && i2c_livre_em[i] < proximo) proximo = i2c_livre_em[i];
+    }
+    if (interrupcoes_desligadas) return proximo;
+    for (int i = 0; i < MAX_ALARMES; i++) {
+        if (alarmes[i].ativo && alarmes[i].alvo < proximo) proximo = alarmes[i].alvo;
+    }
+    for (int i = 0; i < MAX_BORDAS; i++) {
+        if (bordas[i].usada && bordas[i].quando < proximo) proximo = bordas[i].quando;
+    }
+    for (int g = 0; g < NUM_BANK0_GPIOS; g++) {
+        if (pinos[g].eventos_travados && pinos[g].atendimento_em < proximo) proximo = pinos[g].atendimento_em;
+    }
+    return proximo;
+}
+
+static void avancar_ate(uint64_t alvo, tipo_tempo_t tipo) {
+    if (executando && !em_interrupcao && agora_us >= limite_us) longjmp(saida, 1);
+    if (tipo == TEMPO_DORMINDO && alvo > agora_us) estatisticas.despertares++;
+    while (agora_us < alvo) {
+        uint64_t proximo = proximo_evento();
+        if (proximo <= agora_us) proximo = agora_us + 1;
+        if (proximo > alvo) proximo = alvo;
+        if (tipo == TEMPO_DORMINDO) estatisticas.tempo_dormindo_us += proximo - agora_us;
+        else estatisticas.tempo_ocupado_us += proximo - agora_us;
+        agora_us = proximo;
+        processar_eventos();
+    }
+}
+
+static void atender_irq_gpio(uint gpio) {
+    uint32_t eventos = pinos[gpio].eventos_travados;
+    pinos[gpio].eventos_travados = 0;
+    estatisticas.irqs_gpio++;
+    callback_gpio(gpio, eventos);
+}
+
+// Bordas e atendimentos em ordem de tempo; com latência, as bordas que chegam antes do
+// atendimento se juntam na mesma máscara, como no registrador INTR do RP2040
+static void atualizar_pinos(void) {
+    for (;;) {
+        int escolhida = -1;
+        for (int i = 0; i < MAX_BORDAS; i++) {
+            if (!bordas[i].usada || bordas[i].quando > agora_us) continue;
+            if (escolhida < 0 || bordas[i].quando < bordas[escolhida].quando) escolhida = i;
+        }
+        int atender = -1;
+        for (int g = 0; g < NUM_BANK0_GPIOS; g++) {
+            if (!pinos[g].eventos_travados || pinos[g].atendimento_em > agora_us) continue;
+            if (atender < 0 || pinos[g].atendimento_em < pinos[atender].atendimento_em) atender = g;
+        }
+        if (atender >= 0 && (escolhida < 0 || pinos[atender].atendimento_em <= bordas[escolhida].quando)) {
+            atender_irq_gpio((uint)atender);
+            continue;
+        }
+        if (escolhida < 0) return;
+        bordas[escolhida].usada = false;
+
+        uint gpio = bordas[escolhida].gpio;
+        bool antes = gpio_get(gpio);
+        pinos[gpio].pressionado = bordas[escolhida].pressionado;
+        bool depois = gpio_get(gpio);
+        if (antes == depois) continue;
+
+        uint32_t evento = depois ? GPIO_IRQ_EDGE_RISE : GPIO_IRQ_EDGE_FALL;
+        if (!callback_gpio || !(pinos[gpio].eventos_irq & evento)) continue;
+        if (!pinos[gpio].eventos_travados) pinos[gpio].atendimento_em = bordas[escolhida].quando + latencia_irq_gpio_us;
+        pinos[gpio].eventos_travados |= evento;
+        if (latencia_irq_gpio_us == 0) atender_irq_gpio(gpio);
+    }
+}
+
+static void disparar_alarmes(void) {
+    for (;;) {
+        int escolhido = -1;
+        for (int i = 0; i < MAX_ALARMES; i++) {
+            if (!alarmes[i].ativo || alarmes[i].alvo > agora_us) continue;
+            if (escolhido < 0 || alarmes[i].alvo < alarmes[escolhido].alvo) escolhido = i;
+        }
+        if (escolhido < 0) return;
+
+        alarmes[escolhido].ativo = false;
+        estatisticas.alarmes_disparados++;
+        int64_t repetir = alarmes[escolhido].callback(alarmes[escolhido].id, alarmes[escolhido].dados);
+        if (repetir == 0) continue;
+        alarmes[escolhido].alvo = repetir < 0 ? alarmes[escolhido].alvo + (uint64_t)(-repetir)
+                                              : agora_us + (uint64_t)repetir;
+        alarmes[escolhido].ativo = true;
+    }
+}
+
+// ─── ADC: conversões em round robin empurradas para o DMA ─────────────────
+static uint64_t adc_periodo_ns(void) {
+    uint32_t ciclos = (uint32_t)adc_divisor + 1;
+    if (ciclos < ADC_CICLOS_MIN) ciclos = ADC_CICLOS_MIN;
+    return (uint64_t)ciclos * 1000000000u / ADC_CLOCK_HZ;
+}
+
+static void adc_proximo_canal(void) {
+    if (!adc_mascara_rr) return;
+    do {
+        adc_canal = (adc_canal + 1) % 5;
+    } while (!(adc_mascara_rr & (1u << adc_canal)));
+}
+
+static void atualizar_adc(void) {
+    if (!adc_rodando) return;
+    int canal = -1;
+    for (int i = 0; i < NUM_DMA_CHANNELS; i++) {
+        if (canais_dma[i].fluxo_adc && canais_dma[i].contagem > 0) canal = i;
+    }
+    uint64_t periodo = adc_periodo_ns();
+    while (adc_proxima_ns <= agora_us * 1000) {
+        uint16_t valor = adc_valores[adc_canal];
+        if (adc_dreq && canal >= 0) {
+            uint32_t tamanho = 1u << canais_dma[canal].cfg.tamanho;
+            uintptr_t base = (uintptr_t)canais_dma[canal].escrita;
+            uintptr_t deslocamento = (uintptr_t)canais_dma[canal].indice * tamanho;
+            if (canais_dma[canal].cfg.anel_bits) {
+                uintptr_t mascara = ((uintptr_t)1 << canais_dma[canal].cfg.anel_bits) - 1;
+                base &= ~mascara;
+                deslocamento &= mascara;
+            }
+            if (tamanho == 2) *(volatile uint16_t *)(base + deslocamento) = valor;
+            else if (tamanho == 4) *(volatile uint32_t *)(base + deslocamento) = valor;
+            else *(volatile uint8_t *)(base + deslocamento) = (uint8_t)(valor >> 4);
+            canais_dma[canal].indice++;
+            if (--canais_dma[canal].contagem == 0) canal = -1;
+        }
+        sim_adc_hw.result = valor;
+        adc_proximo_canal();
+        adc_proxima_ns += periodo;
+    }
+}
+
+static void atualizar_i2c(void) {
+    for (int i = 0; i < 2; i++) {
+        if (i2c_stop_pendente[i] && agora_us >= i2c_livre_em[i]) {
+            i2c_hw_sim[i].raw_intr_stat |= I2C_IC_RAW_INTR_STAT_STOP_DET_BITS;
+            i2c_stop_pendente[i] = false;
+        }
+    }
+}
+
+static void conferir_origem_dma(canal_dma_sim_t *c) {
+    const volatile uint8_t *origem = (const volatile uint8_t *)c->leitura;
+    for (uint32_t i = 0; i < c->bytes_origem; i++) {
+        if (origem[i] != c->copia_origem[i]) estatisticas.dma_origem_alterada++;
+    }
+    c->conferir_origem = false;
+}
+
+static void atualizar_dma(void) {
+    for (int i = 0; i < NUM_DMA_CHANNELS; i++) {
+        if (canais_dma[i].conferir_origem && agora_us >= canais_dma[i].fim_us) conferir_origem_dma(&canais_dma[i]);
+    }
+}
+
+static void processar_eventos(void) {
+    if (em_interrupcao) return;
+    atualizar_adc();
+    atualizar_i2c();
+    atualizar_dma();
+    if (gancho) gancho(agora_us);
+    if (interrupcoes_desligadas) return;
+    em_interrupcao = true;
+    atualizar_pinos();
+    disparar_alarmes();
+    em_interrupcao = false;
+}
+
+// ─── Tempo e alarmes (pico/stdlib.h) ──────────────────────────────────────
+void stdio_init_all(void) {}
+
+int getchar_timeout_us(uint32_t timeout_us) {
+    avancar_ate(agora_us + timeout_us, TEMPO_DORMINDO);
+    return PICO_ERROR_TIMEOUT;
+}
+
+uint64_t time_us_64(void) {
+    return agora_us;
+}
+
+uint32_t time_us_32(void) {
+    return (uint32_t)agora_us;
+}
+
+absolute_time_t get_absolute_time(void) {
+    return agora_us;
+}
+
+uint32_t to_ms_since_boot(absolute_time_t t) {
+    return (uint32_t)(t / 1000);
+}
+
+uint64_t to_us_since_boot(absolute_time_t t) {
+    return t;
+}
+
+absolute_time_t make_timeout_time_ms(uint32_t ms) {
+    return agora_us + (uint64_t)ms * 1000;
+}
+
+void sleep_us(uint64_t us) {
+    avancar_ate(agora_us + us, TEMPO_DORMINDO);
+}
+
+void sleep_ms(uint32_t ms) {
+    sleep_us((uint64_t)ms * 1000);
+}
+
+void sleep_until(absolute_time_t t) {
+    avancar_ate(t, TEMPO_DORMINDO);
+}
+
+void tight_loop_contents(void) {
+    avancar_ate(agora_us + 1, TEMPO_OCUPADO);
+}
+
+alarm_id_t add_alarm_in_us(uint64_t us, alarm_callback_t callback, void *user_data, bool fire_if_past) {
+    uint64_t alvo = agora_us + us;
+    if (us == 0 && fire_if_past) {
+        int64_t repetir = callback(0, user_data);
+        if (repetir == 0) return 0;
+        alvo = repetir < 0 ? alvo + (uint64_t)(-repetir) : agora_us + (uint64_t)repetir;
+    }
+    for (int i = 0; i < MAX_ALARMES; i++) {
+        if (alarmes[i].ativo) continue;
+        alarmes[i].ativo = true;
+        alarmes[i].id = proximo_id_alarme++;
+        alarmes[i].alvo = alvo;
+        alarmes[i].callback = callback;
+        alarmes[i].dados = user_data;
+        return alarmes[i].id;
+    }
+    return -1;
+}
+
+alarm_id_t add_alarm_in_ms(uint32_t ms, alarm_callback_t callback, void *user_data, bool fire_if_past) {
+    return add_alarm_in_us((uint64_t)ms * 1000, callback, user_data, fire_if_past);
+}
+
+bool cancel_alarm(alarm_id_t alarm_id) {
+    for (int i = 0; i < MAX_ALARMES; i++) {
+        if (alarmes[i].ativo && alarmes[i].id == alarm_id) {
+            alarmes[i].ativo = false;
+            return true;
+        }
+    }
+    return false;
+}
+
+// ─── Interrupções ─────────────────────────────────────────────────────────
+uint32_t save_and_disable_interrupts(void) {
+    uint32_t estado = interrupcoes_desligadas;
+    interrupcoes_desligadas = true;
+    return estado;
+}
+
+void restore_interrupts(uint32_t status) {
+    interrupcoes_desligadas = status != 0;
+    if (!interrupcoes_desligadas) processar_eventos();
+}
+
+// Como no M0+, uma IRQ que fica pendente acorda o núcleo mesmo com as interrupções desligadas;
+// ela só é atendida no restore_interrupts
+void __wfi(void) {
+    bool desligadas = interrupcoes_desligadas;
+    interrupcoes_desligadas = false;
+    uint64_t alvo = proximo_evento();
+    interrupcoes_desligadas = desligadas;
+    if (alvo == UINT64_MAX) alvo = executando ? limite_us : agora_us + 1000;
+    if (alvo <= agora_us) alvo = agora_us + 1;
+    avancar_ate(alvo, TEMPO_DORMINDO);
+}
+
+// ─── GPIO ─────────────────────────────────────────────────────────────────
+void gpio_init(unsigned int gpio) {
+    pinos[gpio].saida = false;
+    pinos[gpio].nivel_saida = false;
+}
+
+void gpio_set_dir(unsigned int gpio, bool out) {
+    pinos[gpio].saida = out;
+}
+
+void gpio_put(unsigned int gpio, bool value) {
+    pinos[gpio].nivel_saida = value;
+}
+
+bool gpio_get(unsigned int gpio) {
+    if (pinos[gpio].saida) return pinos[gpio].nivel_saida;
+    return !pinos[gpio].pressionado && pinos[gpio].pull_up;
+}
+
+void gpio_pull_up(unsigned int gpio) {
+    pinos[gpio].pull_up = true;
+}
+
+void gpio_set_function(unsigned int gpio, enum gpio_function fn) {
+    (void)gpio;
+    (void)fn;
+}
+
+void gpio_set_irq_enabled(unsigned int gpio, uint32_t events, bool enabled) {
+    if (enabled) pinos[gpio].eventos_irq |= events;
+    else pinos[gpio].eventos_irq &= ~events;
+}
+
+void gpio_set_irq_callback(gpio_irq_callback_t callback) {
+    callback_gpio = callback;
+}
+
+void gpio_set_irq_enabled_with_callback(unsigned int gpio, uint32_t events, bool enabled, gpio_irq_callback_t callback) {
+    gpio_set_irq_enabled(gpio, events, enabled);
+    gpio_set_irq_callback(callback);
+}
+
+// ─── Controlador SSD1306 do outro lado do barramento ──────────────────────
+static uint8_t oled_argumentos(uint8_t comando) {
+    switch (comando) {
+        case 0x20: case 0x81: case 0x8D: case 0xA8: case 0xD3:
+        case 0xD5: case 0xD6: case 0xD9: case 0xDA: case 0xDB:
+            return 1;
+        case 0x21: case 0x22: case 0xA3:
+            return 2;
+        case 0x29: case 0x2A:
+            return 5;
+        case 0x26: case 0x27:
+            return 6;
+        default:
+            return 0;
+    }
+}
+
+static void oled_aplicar(uint8_t comando) {
+    const uint8_t *a = ctrl_oled.args;
+    if (comando >= 0x40 && comando <= 0x7F) {
+        oled.linha_inicial = comando & 0x3F;
+        return;
+    }
+    switch (comando) {
+        case 0x21:
+            ctrl_oled.col_ini = a[0] & 0x7F;
+            ctrl_oled.col_fim = a[1] & 0x7F;
+            ctrl_oled.col = ctrl_oled.col_ini;
+            break;
+        case 0x22:
+            ctrl_oled.pag_ini = a[0] & 0x07;
+            ctrl_oled.pag_fim = a[1] & 0x07;
+            ctrl_oled.pag = ctrl_oled.pag_ini;
+            break;
+        case 0x81: oled.contraste = a[0]; break;
+        case 0xA8: oled.multiplex = a[0]; break;
+        case 0xDA: oled.pinos_com = a[0]; break;
+        case 0xA6: oled.invertido = false; break;
+        case 0xA7: oled.invertido = true; break;
+        case 0xAE: oled.ligado = false; break;
+        case 0xAF: oled.ligado = true; break;
+        case 0x2E: oled.rolagem_ativa = false; break;
+        case 0x2F: oled.rolagem_ativa = true; break;
+        default: break;
+    }
+}
+
+static void oled_comando(uint8_t byte) {
+    if (ctrl_oled.faltam) {
+        ctrl_oled.args[ctrl_oled.n++] = byte;
+        if (--ctrl_oled.faltam == 0) oled_aplicar(ctrl_oled.comando);
+        return;
+    }
+    ctrl_oled.comando = byte;
+    ctrl_oled.n = 0;
+    ctrl_oled.faltam = oled_argumentos(byte);
+    if (ctrl_oled.faltam == 0) oled_aplicar(byte);
+}
+
+// Endereçamento horizontal, o único modo que o driver usa
+static void oled_dado(uint8_t byte) {
+    oled.gram[ctrl_oled.pag][ctrl_oled.col] = byte;
+    oled.bytes_dados++;
+    if (oled.rolagem_ativa) oled.dados_rolando++;
+    if (ctrl_oled.col == ctrl_oled.col_fim) {
+        ctrl_oled.col = ctrl_oled.col_ini;
+        ctrl_oled.pag = ctrl_oled.pag == ctrl_oled.pag_fim ? ctrl_oled.pag_ini : (uint8_t)((ctrl_oled.pag + 1) & 7);
+    } else {
+        ctrl_oled.col = (ctrl_oled.col + 1) & 0x7F;
+    }
+}
+
+// Cada START recomeça com um byte de controle: Co=1 vale para um byte, Co=0 para o resto
+static void oled_receber(const uint8_t *bytes, size_t n) {
+    size_t i = 0;
+    while (i < n) {
+        uint8_t controle = bytes[i++];
+        bool dados = controle & 0x40;
+        if (controle & 0x80) {
+            if (i < n) {
+                if (dados) oled_dado(bytes[i]);
+                else oled_comando(bytes[i]);
+                i++;
+            }
+            continue;
+        }
+        for (; i < n; i++) {
+            if (dados) oled_dado(bytes[i]);
+            else oled_comando(bytes[i]);
+        }
+    }
+}
+
+// ─── I2C ──────────────────────────────────────────────────────────────────
+static int indice_i2c(i2c_inst_t *i2c) {
+    return i2c == i2c1 ? 1 : 0;
+}
+
+// START + endereço + dados com ACK a cada 9 bits + STOP
+static uint64_t i2c_duracao_us(i2c_inst_t *i2c, size_t bytes) {
+    uint64_t bits = 2 + 9 * (uint64_t)(bytes + 1);
+    uint baud = i2c->baudrate ? i2c->baudrate : 100000;
+    return (bits * 1000000 + baud - 1) / baud;
+}
+
+static bool i2c_transacao(i2c_inst_t *i2c, uint8_t endereco, const uint8_t *bytes, size_t n) {
+    bool ack = endereco == OLED_ENDERECO && (!i2c_taxa_max_oled || i2c->baudrate <= i2c_taxa_max_oled);
+    estatisticas.i2c_transacoes++;
+    estatisticas.i2c_bytes += ack ? n + 1 : 1;
+    estatisticas.i2c_barramento_us += i2c_duracao_us(i2c, ack ? n : 0);
+    if (ack) oled_receber(bytes, n);
+    return ack;
+}
+
+uint i2c_init(i2c_inst_t *i2c, uint baudrate) {
+    i2c->hw->enable = 1;
+    return i2c_set_baudrate(i2c, baudrate);
+}
+
+uint i2c_set_baudrate(i2c_inst_t *i2c, uint baudrate) {
+    i2c->baudrate = baudrate;
+    return baudrate;
+}
+
+int i2c_write_blocking(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop) {
+    (void)nostop;
+    int n = indice_i2c(i2c);
+    if (i2c_livre_em[n] > agora_us) avancar_ate(i2c_livre_em[n], TEMPO_OCUPADO);
+    bool ack = i2c_transacao(i2c, addr, src, len);
+    avancar_ate(agora_us + i2c_duracao_us(i2c, ack ? len : 0), TEMPO_OCUPADO);
+    return ack ? (int)len : PICO_ERROR_GENERIC;
+}
+
+int i2c_write_timeout_us(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop, uint timeout_us) {
+    (void)timeout_us;
+    return i2c_write_blocking(i2c, addr, src, len, nostop);
+}
+
+uint i2c_get_dreq(i2c_inst_t *i2c, bool is_tx) {
+    return DREQ_I2C0_TX + 2 * (uint)indice_i2c(i2c) + (is_tx ? 0 : 1);
+}
+
+// Palavras de 16 bits em DATA_CMD: RESTART abre uma transação nova, STOP fecha a atual
+static uint64_t i2c_fluxo_dma(int n, const volatile uint16_t *palavras, uint32_t contagem) {
+    i2c_inst_t *i2c = n ? i2c1 : i2c0;
+    i2c_hw_t *hw = &i2c_hw_sim[n];
+    uint8_t transacao[2048];
+    size_t tamanho = 0;
+    uint64_t duracao = 0;
+    bool abortou = false;
+
+    hw->raw_intr_stat = 0;
+    for (uint32_t i = 0; i < contagem; i++) {
+        uint16_t palavra = palavras[i];
+        if ((palavra & I2C_IC_DATA_CMD_RESTART_BITS) && tamanho) {
+            abortou |= !i2c_transacao(i2c, (uint8_t)hw->tar, transacao, tamanho);
+            duracao += i2c_duracao_us(i2c, tamanho);
+            tamanho = 0;
+        }
+        if (tamanho < sizeof(transacao)) transacao[tamanho++] = (uint8_t)palavra;
+        if ((palavra & I2C_IC_DATA_CMD_STOP_BITS) || i + 1 == contagem) {
+            abortou |= !i2c_transacao(i2c, (uint8_t)hw->tar, transacao, tamanho);
+            duracao += i2c_duracao_us(i2c, tamanho);
+            tamanho = 0;
+        }
+    }
+
+    uint64_t inicio = i2c_livre_em[n] > agora_us ? i2c_livre_em[n] : agora_us;
+    i2c_livre_em[n] = inicio + duracao;
+    i2c_stop_pendente[n] = true;
+    if (abortou) hw->raw_intr_stat |= I2C_IC_RAW_INTR_STAT_TX_ABRT_BITS;
+
+    // O DMA termina quando o último byte entra na FIFO, não quando sai no fio
+    uint64_t folga_fifo = i2c_duracao_us(i2c, I2C_FIFO_BYTES);
+    return duracao > folga_fifo ? i2c_livre_em[n] - folga_fifo : inicio;
+}
+
+// ─── ADC ──────────────────────────────────────────────────────────────────
+void adc_init(void) {
+    sim_adc_hw.cs = ADC_CS_READY_BITS;
+    adc_rodando = false;
+    adc_mascara_rr = 0;
+    adc_canal = 0;
+}
+
+void adc_gpio_init(uint gpio) {
+    pinos[gpio].pull_up = false;
+}
+
+void adc_select_input(uint input) {
+    adc_canal = input % 5;
+}
+
+uint16_t adc_read(void) {
+    avancar_ate(agora_us + ADC_CONVERSAO_US, TEMPO_OCUPADO);
+    uint16_t valor = adc_valores[adc_canal];
+    sim_adc_hw.result = valor;
+    return valor;
+}
+
+void adc_set_round_robin(uint input_mask) {
+    adc_mascara_rr = input_mask & 0x1F;
+}
+
+void adc_fifo_setup(bool en, bool dreq_en, uint16_t dreq_thresh, bool err_in_fifo, bool byte_shift) {
+    (void)dreq_thresh;
+    (void)err_in_fifo;
+    (void)byte_shift;
+    adc_dreq = en && dreq_en;
+}
+
+void adc_fifo_drain(void) {}
+
+void adc_set_clkdiv(float clkdiv) {
+    adc_divisor = clkdiv;
+}
+
+void adc_run(bool run) {
+    if (run && !adc_rodando) adc_proxima_ns = agora_us * 1000 + adc_periodo_ns();
+    adc_rodando = run;
+}
+
+// ─── PWM ──────────────────────────────────────────────────────────────────
+void pwm_set_clkdiv_int_frac(uint slice_num, uint8_t integer, uint8_t fract) {
+    (void)slice_num;
+    (void)integer;
+    (void)fract;
+}
+
+void pwm_set_wrap(uint slice_num, uint16_t wrap) {
+    pwm_topos[slice_num] = wrap;
+    estatisticas.pwm_mudancas++;
+}
+
+void pwm_set_chan_level(uint slice_num, uint chan, uint16_t level) {
+    pwm_niveis[slice_num][chan] = level;
+    estatisticas.pwm_mudancas++;
+}
+
+void pwm_set_enabled(uint slice_num, bool enabled) {
+    (void)slice_num;
+    (void)enabled;
+}
+
+// ─── PIO: a máquina de estados só alimenta a matriz WS2812 ────────────────
+static void ws2812_receber(uint32_t palavra) {
+    uint64_t inicio = pio_livre_em > agora_us ? pio_livre_em : agora_us;
+    if (inicio >= pio_livre_em + WS2812_RESET_US) matriz_indice = 0;
+    matriz_recebendo[matriz_indice++] = palavra >> 8;
+    if (matriz_indice == SIM_MATRIZ_PIXELS) {
+        memcpy(matriz_exibida, matriz_recebendo, sizeof(matriz_exibida));
+        estatisticas.matriz_quadros++;
+        matriz_indice = 0;
+    }
+    pio_livre_em = inicio + WS2812_US_POR_PIXEL;
+}
+
+uint pio_add_program(PIO pio, const pio_program_t *program) {
+    (void)pio;
+    (void)program;
+    return 0;
+}
+
+void pio_gpio_init(PIO pio, uint pin) {
+    (void)pio;
+    (void)pin;
+}
+
+void pio_sm_set_consecutive_pindirs(PIO pio, uint sm, uint pin_base, uint pin_count, bool is_out) {
+    (void)pio;
+    (void)sm;
+    (void)pin_base;
+    (void)pin_count;
+    (void)is_out;
+}
+
+void pio_sm_init(PIO pio, uint sm, uint initial_pc, const pio_sm_config *config) {
+    (void)pio;
+    (void)sm;
+    (void)initial_pc;
+    (void)config;
+}
+
+void pio_sm_set_enabled(PIO pio, uint sm, bool enabled) {
+    (void)pio;
+    (void)sm;
+    (void)enabled;
+}
+
+void pio_sm_put_blocking(PIO pio, uint sm, uint32_t data) {
+    (void)pio;
+    (void)sm;
+    uint64_t capacidade_us = PIO_FIFO_PALAVRAS * WS2812_US_POR_PIXEL;
+    if (pio_livre_em > agora_us + capacidade_us) avancar_ate(pio_livre_em - capacidade_us, TEMPO_OCUPADO);
+    ws2812_receber(data);
+}
+
+uint pio_get_dreq(PIO pio, uint sm, bool is_tx) {
+    return DREQ_PIO0_TX0 + (pio == pio1 ? 8 : 0) + sm + (is_tx ? 0 : 4);
+}
+
+pio_sm_config pio_get_default_sm_config(void) {
+    pio_sm_config c = { 0 };
+    return c;
+}
+
+void sm_config_set_wrap(pio_sm_config *c, uint wrap_target, uint wrap) {
+    c->execctrl = (wrap_target << 7) | (wrap << 12);
+}
+
+void sm_config_set_sideset(pio_sm_config *c, uint bit_count, bool optional, bool pindirs) {
+    (void)c;
+    (void)bit_count;
+    (void)optional;
+    (void)pindirs;
+}
+
+void sm_config_set_sideset_pins(pio_sm_config *c, uint sideset_base) {
+    c->pinctrl = sideset_base;
+}
+
+void sm_config_set_out_shift(pio_sm_config *c, bool shift_right, bool autopull, uint pull_threshold) {
+    c->shiftctrl = (shift_right ? 1u : 0u) | (autopull ? 2u : 0u) | (pull_threshold << 2);
+}
+
+void sm_config_set_fifo_join(pio_sm_config *c, enum pio_fifo_join join) {
+    (void)c;
+    (void)join;
+}
+
+void sm_config_set_clkdiv(pio_sm_config *c, float div) {
+    c->clkdiv = (uint32_t)(div * 256.0f);
+}
+
+uint32_t clock_get_hz(enum clock_index clk_index) {
+    return clk_index == clk_usb || clk_index == clk_adc ? 48000000u : CLOCK_SISTEMA_HZ;
+}
+
+// ─── DMA ──────────────────────────────────────────────────────────────────
+int dma_claim_unused_channel(bool required) {
+    for (int i = 0; i < NUM_DMA_CHANNELS; i++) {
+        if (!canais_dma[i].reservado) {
+            canais_dma[i].reservado = true;
+            return i;
+        }
+    }
+    if (required) {
+        fprintf(stderr, "sim: nenhum canal de DMA livre\n");
+        abort();
+    }
+    return -1;
+}
+
+void dma_channel_unclaim(uint channel) {
+    canais_dma[channel].reservado = false;
+}
+
+dma_channel_config dma_channel_get_default_config(uint channel) {
+    (void)channel;
+    dma_channel_config c = { DMA_SIZE_32, true, false, false, 0, 0x3F };
+    return c;
+}
+
+void channel_config_set_transfer_data_size(dma_channel_config *c, enum dma_channel_transfer_size size) {
+    c->tamanho = (uint8_t)size;
+}
+
+void channel_config_set_read_increment(dma_channel_config *c, bool incr) {
+    c->incrementa_leitura = incr;
+}
+
+void channel_config_set_write_increment(dma_channel_config *c, bool incr) {
+    c->incrementa_escrita = incr;
+}
+
+void channel_config_set_ring(dma_channel_config *c, bool write, uint size_bits) {
+    c->anel_na_escrita = write;
+    c->anel_bits = (uint8_t)size_bits;
+}
+
+void channel_config_set_dreq(dma_channel_config *c, uint dreq) {
+    c->dreq = dreq;
+}
+
+// Guarda a origem de uma transferência que ainda vai levar tempo para conferir no fim
+static void guardar_origem_dma(canal_dma_sim_t *c, uint32_t bytes) {
+    c->conferir_origem = c->fim_us > agora_us && bytes <= DMA_COPIA_BYTES;
+    if (!c->conferir_origem) return;
+    c->bytes_origem = bytes;
+    const volatile uint8_t *origem = (const volatile uint8_t *)c->leitura;
+    for (uint32_t i = 0; i < bytes; i++) c->copia_origem[i] = origem[i];
+}
+
+// O destino decide o que a transferência representa: fio I2C, FIFO da PIO, fluxo do ADC ou memória
+static void dma_disparar(uint channel) {
+    canal_dma_sim_t *c = &canais_dma[channel];
+    c->fluxo_adc = false;
+    c->indice = 0;
+    if (c->conferir_origem) conferir_origem_dma(c);
+    c->fim_us = agora_us;
+
+    for (int n = 0; n < 2; n++) {
+        if (c->escrita == &i2c_hw_sim[n].data_cmd) {
+            c->fim_us = i2c_fluxo_dma(n, (const volatile uint16_t *)c->leitura, c->contagem);
+            guardar_origem_dma(c, c->contagem * sizeof(uint16_t));
+            return;
+        }
+    }
+    for (int p = 0; p < 2; p++) {
+        for (int sm = 0; sm < 4; sm++) {
+            if (c->escrita != &sim_pio_hw[p].txf[sm]) continue;
+            const volatile uint32_t *palavras = (const volatile uint32_t *)c->leitura;
+            for (uint32_t i = 0; i < c->contagem; i++) ws2812_receber(palavras[i]);
+            uint64_t na_fifo = (uint64_t)PIO_FIFO_PALAVRAS * WS2812_US_POR_PIXEL;
+            c->fim_us = pio_livre_em > agora_us + na_fifo ? pio_livre_em - na_fifo : agora_us;
+            guardar_origem_dma(c, c->contagem * sizeof(uint32_t));
+            return;
+        }
+    }
+    if (c->leitura == &sim_adc_hw.fifo) {
+        c->fluxo_adc = true;
+        return;
+    }
+
+    uint32_t tamanho = 1u << c->cfg.tamanho;
+    for (uint32_t i = 0; i < c->contagem; i++) {
+        const volatile uint8_t *origem = (const volatile uint8_t *)c->leitura + (c->cfg.incrementa_leitura ? i * tamanho : 0);
+        volatile uint8_t *destino = (volatile uint8_t *)c->escrita + (c->cfg.incrementa_escrita ? i * tamanho : 0);
+        for (uint32_t b = 0; b < tamanho; b++) destino[b] = origem[b];
+    }
+    c->contagem = 0;
+}
+
+void dma_channel_configure(uint channel, const dma_channel_config *config, volatile void *write_addr,
+                           const volatile void *read_addr, uint transfer_count, bool trigger) {
+    canais_dma[channel].cfg = *config;
+    canais_dma[channel].escrita = write_addr;
+    canais_dma[channel].leitura = read_addr;
+    canais_dma[channel].contagem = transfer_count;
+    if (trigger) dma_disparar(channel);
+}
+
+void dma_channel_transfer_from_buffer_now(uint channel, const volatile void *read_addr, uint32_t transfer_count) {
+    canais_dma[channel].leitura = read_addr;
+    canais_dma[channel].contagem = transfer_count;
+    dma_disparar(channel);
+}
+
+void dma_channel_transfer_to_buffer_now(uint channel, volatile void *write_addr, uint32_t transfer_count) {
+    canais_dma[channel].escrita = write_addr;
+    canais_dma[channel].contagem = transfer_count;
+    dma_disparar(channel);
+}
+
+void dma_channel_abort(uint channel) {
+    if (canais_dma[channel].conferir_origem) conferir_origem_dma(&canais_dma[channel]);
+    canais_dma[channel].fluxo_adc = false;
+    canais_dma[channel].contagem = 0;
+    canais_dma[channel].fim_us = agora_us;
+}
+
+bool dma_channel_is_busy(uint channel) {
+    if (canais_dma[channel].fluxo_adc) return canais_dma[channel].contagem > 0;
+    return agora_us < canais_dma[channel].fim_us;
+}
+
+void dma_channel_wait_for_finish_blocking(uint channel) {
+    while (dma_channel_is_busy(channel)) {
+        if (canais_dma[channel].fluxo_adc) tight_loop_contents();
+        else avancar_ate(canais_dma[channel].fim_us, TEMPO_OCUPADO);
+    }
+}
+
+// ─── USB CDC: FIFO de transmissão esvaziada pelo host a cada quadro USB ────
+static void usb_drenar(void) {
+    uint64_t quadros = (agora_us - usb_drenado_em) / USB_QUADRO_US;
+    if (quadros == 0) return;
+    usb_drenado_em += quadros * USB_QUADRO_US;
+    uint64_t drenados = quadros * USB_BYTES_POR_QUADRO;
+    usb_fifo_bytes = drenados >= usb_fifo_bytes ? 0 : usb_fifo_bytes - (uint32_t)drenados;
+}
+
+bool tud_cdc_connected(void) {
+    return true;
+}
+
+uint32_t tud_cdc_write_available(void) {
+    usb_drenar();
+    return CFG_TUD_CDC_TX_BUFSIZE - usb_fifo_bytes;
+}
+
+uint32_t tud_cdc_write(const void *buffer, uint32_t bufsize) {
+    uint32_t livre = tud_cdc_write_available();
+    uint32_t n = bufsize < livre ? bufsize : livre;
+    usb_fifo_bytes += n;
+    estatisticas.usb_bytes += n;
+    if (saida_usb && n) saida_usb(buffer, n);
+    return n;
+}
+
+uint32_t tud_cdc_write_flush(void) {
+    return usb_fifo_bytes;
+}
+
+// ─── Núcleo 1 ─────────────────────────────────────────────────────────────
+static void sem_nucleo1(void) {
+    fprintf(stderr, "sim: o núcleo 1 não é simulado (compile sem RENDER_NUCLEO1)\n");
+    abort();
+}
+
+void multicore_launch_core1(void (*entry)(void)) {
+    (void)entry;
+    sem_nucleo1();
+}
+
+void multicore_fifo_push_blocking(uint32_t data) {
+    (void)data;
+    sem_nucleo1();
+}
+
+uint32_t multicore_fifo_pop_blocking(void) {
+    sem_nucleo1();
+    return 0;
+}
+
+bool multicore_fifo_wready(void) {
+    return false;
+}
+
+bool multicore_fifo_rvalid(void) {
+    return false;
+}
+
+// ─── Controle do simulador (sim.h) ────────────────────────────────────────
+void sim_reiniciar(void) {
+    agora_us = 0;
+    gancho = NULL;
+    interrupcoes_desligadas = false;
+    em_interrupcao = false;
+    memset(&estatisticas, 0, sizeof(estatisticas));
+    memset(pinos, 0, sizeof(pinos));
+    latencia_irq_gpio_us = 0;
+    memset(bordas, 0, sizeof(bordas));
+    memset(alarmes, 0, sizeof(alarmes));
+    memset(i2c_hw_sim, 0, sizeof(i2c_hw_sim));
+    memset(i2c_livre_em, 0, sizeof(i2c_livre_em));
+    memset(i2c_stop_pendente, 0, sizeof(i2c_stop_pendente));
+    memset(canais_dma, 0, sizeof(canais_dma));
+    memset(pwm_niveis, 0, sizeof(pwm_niveis));
+    memset(pwm_topos, 0, sizeof(pwm_topos));
+    memset(&oled, 0, sizeof(oled));
+    memset(&ctrl_oled, 0, sizeof(ctrl_oled));
+    memcpy(adc_valores, ADC_PADRAO, sizeof(adc_valores));
+    callback_gpio = NULL;
+    adc_rodando = false;
+    pio_livre_em = 0;
+    matriz_indice = 0;
+    usb_fifo_bytes = 0;
+    usb_drenado_em = 0;
+    saida_usb = NULL;
+    i2c_taxa_max_oled = 0;
+    ctrl_oled.col_fim = SIM_OLED_LARGURA - 1;
+    ctrl_oled.pag_fim = SIM_OLED_PAGINAS - 1;
+}
+
+uint64_t sim_executar(int (*principal)(void), uint64_t limite) {
+    limite_us = limite;
+    executando = true;
+    if (setjmp(saida) == 0) principal();
+    executando = false;
+    em_interrupcao = false;
+    return agora_us;
+}
+
+void sim_definir_gancho(sim_gancho_t novo) {
+    gancho = novo;
+}
+
+void sim_limitar_i2c_oled(unsigned int taxa_max) {
+    i2c_taxa_max_oled = taxa_max;
+}
+
+void sim_definir_usb(sim_usb_saida_t saida) {
+    saida_usb = saida;
+}
+
+uint64_t sim_agora_us(void) {
+    return agora_us;
+}
+
+void sim_definir_adc(unsigned int canal, uint16_t valor) {
+    if (canal < 5) adc_valores[canal] = valor & 0x0FFF;
+}
+
+static void agendar_borda(unsigned int gpio, uint64_t quando, bool pressionado) {
+    for (int i = 0; i < MAX_BORDAS; i++) {
+        if (bordas[i].usada) continue;
+        bordas[i].usada = true;
+        bordas[i].quando = quando;
+        bordas[i].gpio = (uint8_t)gpio;
+        bordas[i].pressionado = pressionado;
+        return;
+    }
+}
+
+void sim_pressionar(unsigned int gpio, uint64_t duracao_us) {
+    agendar_borda(gpio, agora_us, true);
+    agendar_borda(gpio, agora_us + duracao_us, false);
+}
+
+void sim_borda(unsigned int gpio, uint64_t atraso_us, bool pressionado) {
+    agendar_borda(gpio, agora_us + atraso_us, pressionado);
+}
+
+void sim_latencia_irq_gpio(uint64_t latencia_us) {
+    latencia_irq_gpio_us = latencia_us;
+}
+
+bool sim_gpio_saida(unsigned int gpio) {
+    return pinos[gpio].saida && pinos[gpio].nivel_saida;
+}
+
+uint16_t sim_pwm_nivel(unsigned int gpio) {
+    return pwm_niveis[pwm_gpio_to_slice_num(gpio)][pwm_gpio_to_channel(gpio)];
+}
+
+uint16_t sim_pwm_topo(unsigned int gpio) {
+    return pwm_topos[pwm_gpio_to_slice_num(gpio)];
+}
+
+const sim_estatisticas_t *sim_estatisticas(void) {
+    return &estatisticas;
+}
+
+const sim_oled_t *sim_oled(void) {
+    return &oled;
+}
+
+const uint32_t *sim_matriz(void) {
+    return matriz_exibida;
+}
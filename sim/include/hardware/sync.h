@@ -0,0 +1,11 @@
+#ifndef SIM_HARDWARE_SYNC_H
+#define SIM_HARDWARE_SYNC_H
+
+#include "pico/stdlib.h"
+
+// Com as interrupções "desligadas" o relógio virtual não dispara alarmes nem IRQs de GPIO
+uint32_t save_and_disable_interrupts(void);
+void restore_interrupts(uint32_t status);
+void __wfi(void);
+
+#endif // SIM_HARDWARE_SYNC_H
@@ -0,0 +1,13 @@
+// HAL simulada: o núcleo 1 não é simulado (RENDER_NUCLEO1 é recusado no build host)
+#ifndef SIM_PICO_MULTICORE_H
+#define SIM_PICO_MULTICORE_H
+
+#include "pico/stdlib.h"
+
+void multicore_launch_core1(void (*entry)(void));
+void multicore_fifo_push_blocking(uint32_t data);
+uint32_t multicore_fifo_pop_blocking(void);
+bool multicore_fifo_wready(void);
+bool multicore_fifo_rvalid(void);
+
+#endif // SIM_PICO_MULTICORE_H
@@ -0,0 +1,15 @@
+// HAL simulada: subconjunto do TinyUSB (classe CDC) usado pelo jogo
+#ifndef SIM_TUSB_H
+#define SIM_TUSB_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define CFG_TUD_CDC_TX_BUFSIZE 256
+
+bool tud_cdc_connected(void);
+uint32_t tud_cdc_write_available(void);
+uint32_t tud_cdc_write(const void *buffer, uint32_t bufsize);
+uint32_t tud_cdc_write_flush(void);
+
+#endif // SIM_TUSB_H
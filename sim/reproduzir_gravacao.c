@@ -0,0 +1,142 @@
+// Reprodutor de gravações: alimenta a lógica do jogo com as entradas gravadas, um passo por
+// registro e sem esperar o agendador, e confere o hash de cada quadro, a pontuação e as vidas.
+//
+//   Coletor_Pixels_reproducao gravacao.bin
+//
+// A gravação vem do serial do dispositivo (ou do executor headless) compilado com
+// GRAVAR_ENTRADAS=1, extraída por tools/extrair_gravacao.py. Sai com 0 se tudo confere.
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "sim.h"
+#include "hardware/i2c.h"
+#include "ssd1306.h"
+#include "matriz_led.h"
+#include "gravacao.h"
+
+#define I2C_PORT        i2c1
+#define I2C_FREQUENCIA  400000
+#define LARGURA_TELA    128
+#define ALTURA_TELA     64
+#define ENDERECO_OLED   0x3C
+
+extern ssd1306_t display;
+extern int pontuacao, vidas;
+extern bool fim_de_jogo;
+extern int centro_x, centro_y;
+extern void (*fonte_entrada)(uint16_t *x, uint16_t *y);
+void inicializar_leds(void);
+void inicializar_buzzers(void);
+void preparar_partida(uint32_t semente);
+void passo_logica(uint32_t agora);
+void desenhar_quadro(uint32_t agora);
+void iniciar_camadas(void);
+
+static reproducao_registro_t entrada_atual;
+
+static void entrada_gravada(uint16_t *x, uint16_t *y) {
+    *x = entrada_atual.x;
+    *y = entrada_atual.y;
+}
+
+// O mesmo tempo que agendador_tempo_logico_ms daria depois de tantos passos
+static uint32_t tempo_logico_ms(const gravacao_cabecalho_t *cabecalho, uint32_t passos) {
+    return (uint32_t)((uint64_t)passos * cabecalho->passo_us / 1000);
+}
+
+static uint8_t *ler_arquivo(const char *caminho, size_t *tamanho) {
+    FILE *f = fopen(caminho, "rb");
+    if (!f) return NULL;
+    fseek(f, 0, SEEK_END);
+    long n = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    uint8_t *dados = n > 0 ? malloc((size_t)n) : NULL;
+    if (dados && fread(dados, 1, (size_t)n, f) != (size_t)n) {
+        free(dados);
+        dados = NULL;
+    }
+    fclose(f);
+    *tamanho = (size_t)n;
+    return dados;
+}
+
+static double segundos_reais(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec / 1e9;
+}
+
+int main(int argc, char **argv) {
+    if (argc != 2) {
+        fprintf(stderr, "uso: %s gravacao.bin\n", argv[0]);
+        return 2;
+    }
+    size_t tamanho;
+    uint8_t *dados = ler_arquivo(argv[1], &tamanho);
+    reproducao_t reproducao;
+    if (!dados || !reproducao_abrir(&reproducao, dados, tamanho)) {
+        fprintf(stderr, "%s: não é uma gravação BRG1\n", argv[1]);
+        return 2;
+    }
+    const gravacao_cabecalho_t *cabecalho = &reproducao.cabecalho;
+
+    sim_reiniciar();
+    i2c_init(I2C_PORT, I2C_FREQUENCIA);
+    ssd1306_init(&display, LARGURA_TELA, ALTURA_TELA, false, ENDERECO_OLED, I2C_PORT);
+    ssd1306_config(&display);
+    ssd1306_init_dma(&display);
+    iniciar_camadas();
+    inicializar_matriz_led();
+    inicializar_leds();
+    inicializar_buzzers();
+
+    fonte_entrada = entrada_gravada;
+    centro_x = cabecalho->centro_x;
+    centro_y = cabecalho->centro_y;
+    preparar_partida(cabecalho->semente);
+
+    uint32_t passos = 0, quadros = 0, divergentes = 0, bordas_botoes = 0;
+    long primeiro_divergente = -1;
+    reproducao_registro_t registro;
+    reproducao_tipo_t tipo;
+    double inicio = segundos_reais();
+    while ((tipo = reproducao_proximo(&reproducao, &registro)) != REPRODUCAO_FIM) {
+        if (tipo == REPRODUCAO_ERRO) {
+            fprintf(stderr, "%s: registro inválido no byte %zu\n", argv[1], reproducao.posicao);
+            return 2;
+        }
+        if (tipo == REPRODUCAO_PASSO) {
+            entrada_atual = registro;
+            bordas_botoes += __builtin_popcount(registro.botoes);
+            passos++;
+            if (!fim_de_jogo) passo_logica(tempo_logico_ms(cabecalho, passos));
+        } else {
+            desenhar_quadro(tempo_logico_ms(cabecalho, passos));
+            uint32_t hash = gravacao_hash(&display.ram_buffer[1], display.bufsize - 1);
+            if (hash != registro.hash) {
+                if (primeiro_divergente < 0) primeiro_divergente = quadros;
+                divergentes++;
+            }
+            quadros++;
+        }
+    }
+    ssd1306_wait(&display);
+    double duracao = segundos_reais() - inicio;
+
+    bool final_confere = pontuacao == registro.pontuacao && vidas == registro.vidas && passos == registro.passos;
+    printf("Semente 0x%08lx, passo de %lu us, centro (%u, %u)\n", (unsigned long)cabecalho->semente,
+           (unsigned long)cabecalho->passo_us, cabecalho->centro_x, cabecalho->centro_y);
+    printf("%lu passos e %lu quadros reproduzidos em %.3f s (%.0f passos/s), %lu bordas de botão\n",
+           (unsigned long)passos, (unsigned long)quadros, duracao, duracao > 0 ? passos / duracao : 0.0,
+           (unsigned long)bordas_botoes);
+    printf("Pontuação %d/%d, vidas %d/%d, passos %lu/%lu (reproduzido/gravado)\n", pontuacao, registro.pontuacao,
+           vidas, registro.vidas, (unsigned long)passos, (unsigned long)registro.passos);
+    if (divergentes) {
+        printf("DIVERGE: %lu quadros com hash diferente, o primeiro é o quadro %ld\n",
+               (unsigned long)divergentes, primeiro_divergente);
+    }
+    bool confere = final_confere && divergentes == 0;
+    printf("%s\n", confere ? "OK: reprodução idêntica à gravação" : "FALHOU: reprodução diverge da gravação");
+    free(dados);
+    return confere ? 0 : 1;
+}
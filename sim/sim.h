@@ -0,0 +1,74 @@
+// Controle da HAL simulada: relógio virtual, entradas roteirizadas e estatísticas dos barramentos.
+// Os drivers do jogo não enxergam este arquivo; só o executor headless e ferramentas do host.
+#ifndef SIM_H
+#define SIM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#define SIM_OLED_LARGURA 128
+#define SIM_OLED_PAGINAS 8
+#define SIM_MATRIZ_PIXELS 25
+
+// Chamado a cada avanço do relógio virtual, antes de alarmes e IRQs; é onde o roteiro de entrada age
+typedef void (*sim_gancho_t)(uint64_t agora_us);
+// Recebe os bytes que o jogo escreve no CDC USB, na ordem em que saem
+typedef void (*sim_usb_saida_t)(const uint8_t *bytes, size_t n);
+
+typedef struct {
+    uint64_t tempo_dormindo_us;        // sleep_*: folga da CPU
+    uint64_t tempo_ocupado_us;         // Esperas ativas por barramento, DMA, FIFO ou ADC
+    uint32_t despertares;              // Cada sleep_* ou __wfi que dormiu: quantas vezes a CPU acordou
+    uint64_t i2c_bytes;                // Inclui o byte de endereço de cada transação
+    uint32_t i2c_transacoes;
+    uint64_t i2c_barramento_us;        // Tempo de fio no clock configurado
+    uint32_t matriz_quadros;           // Quadros completos de 25 pixels recebidos pela matriz
+    uint32_t pwm_mudancas;             // Alterações de nível/wrap nos buzzers
+    uint32_t alarmes_disparados;
+    uint32_t irqs_gpio;
+    uint64_t usb_bytes;                // Aceitos pela FIFO de transmissão do CDC
+    uint32_t dma_origem_alterada;      // Bytes que o programa mudou na origem de um DMA ainda em andamento
+} sim_estatisticas_t;
+
+// Estado do controlador SSD1306 reconstruído a partir do tráfego I2C
+typedef struct {
+    uint8_t gram[SIM_OLED_PAGINAS][SIM_OLED_LARGURA];
+    bool ligado;
+    bool invertido;
+    bool rolagem_ativa;
+    uint8_t contraste;
+    uint8_t linha_inicial;
+    uint8_t multiplex;                 // Linhas - 1 (0xA8)
+    uint8_t pinos_com;                 // Configuração dos pinos COM (0xDA): 0x02 em 32 linhas, 0x12 em 64
+    uint32_t bytes_dados;
+    uint32_t dados_rolando;            // Escritos na GDDRAM com a rolagem ligada (o datasheet proíbe)
+} sim_oled_t;
+
+void sim_reiniciar(void);
+// Executa principal() até o relógio virtual passar de limite_us; retorna o tempo virtual final
+uint64_t sim_executar(int (*principal)(void), uint64_t limite_us);
+void sim_definir_gancho(sim_gancho_t gancho);
+void sim_definir_usb(sim_usb_saida_t saida);
+// Painel que não aguenta o barramento acima de taxa_max: NAK no endereço (0 volta ao normal)
+void sim_limitar_i2c_oled(unsigned int taxa_max);
+
+uint64_t sim_agora_us(void);
+void sim_definir_adc(unsigned int canal, uint16_t valor);
+// Puxa o pino para 0 por duracao_us a partir de agora (botões têm pull-up)
+void sim_pressionar(unsigned int gpio, uint64_t duracao_us);
+// Uma borda crua daqui a atraso_us, para montar contatos com ressalto
+void sim_borda(unsigned int gpio, uint64_t atraso_us, bool pressionado);
+// Atraso entre a primeira borda travada e o atendimento da IRQ de GPIO; as bordas que chegam
+// nesse meio vão juntas numa máscara só (ex.: GPIO_IRQ_EDGE_FALL | GPIO_IRQ_EDGE_RISE)
+void sim_latencia_irq_gpio(uint64_t latencia_us);
+bool sim_gpio_saida(unsigned int gpio);
+// Nível de comparação e topo do contador PWM do pino: nível 0 é buzzer mudo
+uint16_t sim_pwm_nivel(unsigned int gpio);
+uint16_t sim_pwm_topo(unsigned int gpio);
+
+const sim_estatisticas_t *sim_estatisticas(void);
+const sim_oled_t *sim_oled(void);
+const uint32_t *sim_matriz(void);      // Último quadro GRB recebido pela matriz
+
+#endif // SIM_H
@@ -0,0 +1,28 @@
+// Conferências dos testes de host: cada falha sai com arquivo e linha, e o teste termina com
+// RESULTADO_TESTE(), que é 1 se alguma conferência falhou (o ctest lê o código de saída).
+#ifndef TESTE_H
+#define TESTE_H
+
+#include <stdio.h>
+
+static int falhas_teste;
+
+#define CONFERIR(condicao) do { \
+    if (!(condicao)) { \
+        fprintf(stderr, "%s:%d: falhou: %s\n", __FILE__, __LINE__, #condicao); \
+        falhas_teste++; \
+    } \
+} while (0)
+
+#define CONFERIR_IGUAL(obtido, esperado) do { \
+    long long obtido_ = (long long)(obtido), esperado_ = (long long)(esperado); \
+    if (obtido_ != esperado_) { \
+        fprintf(stderr, "%s:%d: %s = %lld, esperado %s = %lld\n", __FILE__, __LINE__, \
+                #obtido, obtido_, #esperado, esperado_); \
+        falhas_teste++; \
+    } \
+} while (0)
+
+#define RESULTADO_TESTE() (falhas_teste ? 1 : 0)
+
+#endif // TESTE_H
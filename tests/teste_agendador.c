@@ -0,0 +1,85 @@
+// Agendador de passo fixo contra um relógio falso: quantos passos cabem num intervalo
+// conhecido, com consulta fina ou grossa, e o descarte do atraso depois de uma parada longa.
+#include "agendador.h"
+#include "teste.h"
+
+#define PASSO_US       30000
+#define RENDER_US      30000
+#define SEGUNDO_US     1000000
+
+static uint64_t agora_us;
+
+static uint64_t relogio_falso(void) {
+    return agora_us;
+}
+
+// Atualiza e executa todos os passos vencidos, como o laço do jogo
+static uint32_t rodar_passos(agendador_t *ag) {
+    uint32_t executados = 0;
+    agendador_atualizar(ag);
+    while (agendador_consumir_passo(ag)) executados++;
+    return executados;
+}
+
+// Consulta a cada intervalo_us durante [inicio, inicio + SEGUNDO_US)
+static uint32_t rodar_segundo(agendador_t *ag, uint64_t inicio, uint32_t intervalo_us) {
+    uint32_t passos = 0;
+    for (agora_us = inicio; agora_us < inicio + SEGUNDO_US; agora_us += intervalo_us) passos += rodar_passos(ag);
+    return passos;
+}
+
+int main(void) {
+    agendador_t ag;
+    // Prazos em 0, 30, ..., 990 ms: 34 passos no primeiro segundo
+    const uint32_t passos_no_segundo = SEGUNDO_US / PASSO_US + 1;
+
+    // Consulta a cada 1 ms: todo passo sai no prazo, e desenha junto com cada passo
+    agora_us = 0;
+    agendador_iniciar(&ag, relogio_falso, PASSO_US, RENDER_US);
+    uint32_t renders = 0;
+    for (agora_us = 0; agora_us < SEGUNDO_US; agora_us += 1000) {
+        if (rodar_passos(&ag) && agendador_deve_renderizar(&ag)) renders++;
+    }
+    CONFERIR_IGUAL(ag.passos, passos_no_segundo);
+    CONFERIR_IGUAL(agendador_tempo_logico_ms(&ag), passos_no_segundo * PASSO_US / 1000);
+    CONFERIR_IGUAL(ag.prazos_perdidos, 0);
+    CONFERIR_IGUAL(ag.jitter_max_us, 0);
+    CONFERIR_IGUAL(renders, passos_no_segundo);
+    CONFERIR_IGUAL(ag.renders_pulados, 0);
+
+    // Consulta a cada 50 ms, a última em 950 ms: todos os prazos até ela, alguns em dobro
+    agora_us = 0;
+    agendador_iniciar(&ag, relogio_falso, PASSO_US, RENDER_US);
+    CONFERIR_IGUAL(rodar_segundo(&ag, 0, 50000), (SEGUNDO_US - 50000) / PASSO_US + 1);
+    CONFERIR(ag.prazos_perdidos > 0);
+    CONFERIR_IGUAL(ag.passos_descartados, 0);
+
+    // Parada longa: só AGENDADOR_MAX_PASSOS passos são recuperados, o resto é descartado
+    // e o prazo seguinte recomeça um passo depois de agora, sem rajada na próxima consulta
+    agora_us = 0;
+    agendador_iniciar(&ag, relogio_falso, PASSO_US, RENDER_US);
+    rodar_segundo(&ag, 0, 1000);
+    uint32_t passos_antes = ag.passos;
+    uint64_t parada_us = 2 * SEGUNDO_US;
+    uint64_t vencidos = 1 + (agora_us + parada_us - ag.proximo_passo_us) / PASSO_US;
+    agora_us += parada_us;
+    CONFERIR_IGUAL(agendador_atualizar(&ag), AGENDADOR_MAX_PASSOS);
+    while (agendador_consumir_passo(&ag)) {}
+    CONFERIR_IGUAL(ag.passos - passos_antes, AGENDADOR_MAX_PASSOS);
+    CONFERIR_IGUAL(ag.passos_descartados, vencidos - AGENDADOR_MAX_PASSOS);
+    CONFERIR_IGUAL(ag.proximo_passo_us, agora_us + PASSO_US);
+    agora_us += PASSO_US - 1;
+    CONFERIR_IGUAL(rodar_passos(&ag), 0);
+    agora_us += 1;
+    CONFERIR_IGUAL(rodar_passos(&ag), 1);
+    // Depois da parada o ritmo volta ao normal
+    CONFERIR_IGUAL(rodar_segundo(&ag, agora_us + PASSO_US, PASSO_US), SEGUNDO_US / PASSO_US + 1);
+
+    // Pausa: sincronizar abandona o tempo parado sem contar como descarte
+    uint32_t descartados = ag.passos_descartados;
+    agora_us += 5 * SEGUNDO_US;
+    agendador_sincronizar(&ag);
+    CONFERIR_IGUAL(rodar_passos(&ag), 1);
+    CONFERIR_IGUAL(ag.passos_descartados, descartados);
+    return RESULTADO_TESTE();
+}
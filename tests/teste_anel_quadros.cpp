@@ -0,0 +1,117 @@
+// Anel de quadros entre dois núcleos, com um std::thread de cada lado: o consumidor vê os
+// quadros em ordem, nunca um quadro pela metade, e todo quadro publicado é apresentado ou
+// contado como pulado. Antes, com uma thread só, o comportamento de anel cheio e vazio.
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include "anel_quadros.h"
+#include "teste.h"
+
+static const uint32_t NUM_QUADROS = 200000;
+
+// O quadro inteiro deriva da sequência: um byte fora do lugar é um quadro rasgado
+static void montar(quadro_t *quadro, uint32_t sequencia) {
+    std::memcpy(quadro->tela, &sequencia, sizeof(sequencia));
+    for (size_t i = sizeof(sequencia); i < sizeof(quadro->tela); i++) {
+        quadro->tela[i] = (uint8_t)(sequencia * 31 + i);
+    }
+    quadro->vidas = (int8_t)(sequencia % 4);
+    quadro->pausado = sequencia & 1;
+    quadro->contraste = (uint8_t)sequencia;
+    quadro->invertida = sequencia & 2;
+    quadro->letreiro = sequencia & 4;
+}
+
+static uint32_t sequencia_de(const quadro_t *quadro) {
+    uint32_t sequencia;
+    std::memcpy(&sequencia, quadro->tela, sizeof(sequencia));
+    return sequencia;
+}
+
+static bool inteiro(const quadro_t *quadro) {
+    static quadro_t esperado;
+    montar(&esperado, sequencia_de(quadro));
+    return std::memcmp(quadro, &esperado, sizeof(esperado)) == 0;
+}
+
+static void publicar(anel_quadros_t *anel, uint32_t sequencia) {
+    quadro_t *quadro = anel_quadros_reservar(anel);
+    CONFERIR(quadro != NULL);
+    if (quadro == NULL) return;
+    montar(quadro, sequencia);
+    CONFERIR_IGUAL(anel_quadros_publicar(anel), sequencia);
+}
+
+static void testar_cheio_e_vazio() {
+    static anel_quadros_t anel;
+    anel_quadros_iniciar(&anel);
+    CONFERIR(anel_quadros_proximo(&anel) == NULL);
+
+    for (uint32_t s = 1; s <= ANEL_QUADROS_CAPACIDADE; s++) publicar(&anel, s);
+    CONFERIR(anel_quadros_reservar(&anel) == NULL);
+    CONFERIR_IGUAL(anel.descartados, 1);
+
+    // O consumidor pula direto para o mais novo, e o slot que ele segura conta como ocupado
+    quadro_t *quadro = anel_quadros_proximo(&anel);
+    CONFERIR(quadro != NULL && sequencia_de(quadro) == ANEL_QUADROS_CAPACIDADE && inteiro(quadro));
+    CONFERIR_IGUAL(anel.pulados, ANEL_QUADROS_CAPACIDADE - 1);
+    for (uint32_t s = 1; s < ANEL_QUADROS_CAPACIDADE; s++) publicar(&anel, ANEL_QUADROS_CAPACIDADE + s);
+    CONFERIR(anel_quadros_reservar(&anel) == NULL);
+    anel_quadros_liberar(&anel);
+    quadro = anel_quadros_proximo(&anel);
+    CONFERIR(quadro != NULL && sequencia_de(quadro) == 2 * ANEL_QUADROS_CAPACIDADE - 1 && inteiro(quadro));
+    CONFERIR_IGUAL(anel.pulados, 2 * ANEL_QUADROS_CAPACIDADE - 3);
+    anel_quadros_liberar(&anel);
+    CONFERIR(anel_quadros_proximo(&anel) == NULL);
+}
+
+static void testar_duas_threads() {
+    static anel_quadros_t anel;
+    anel_quadros_iniciar(&anel);
+    std::atomic<bool> fora_de_ordem(false), rasgado(false);
+    uint32_t apresentados = 0;
+
+    std::thread consumidor([&] {
+        uint32_t ultima = 0;
+        while (ultima != NUM_QUADROS) {
+            quadro_t *quadro = anel_quadros_proximo(&anel);
+            if (quadro == NULL) {
+                std::this_thread::yield();
+                continue;
+            }
+            uint32_t sequencia = sequencia_de(quadro);
+            if (sequencia <= ultima) fora_de_ordem = true;
+            if (!inteiro(quadro)) rasgado = true;
+            ultima = sequencia;
+            apresentados++;
+            anel_quadros_liberar(&anel);
+        }
+    });
+    std::thread produtor([&] {
+        for (uint32_t s = 1; s <= NUM_QUADROS;) {
+            quadro_t *quadro = anel_quadros_reservar(&anel);
+            if (quadro == NULL) {
+                std::this_thread::yield();
+                continue;
+            }
+            montar(quadro, s);
+            anel_quadros_publicar(&anel);
+            s++;
+        }
+    });
+    produtor.join();
+    consumidor.join();
+
+    CONFERIR(!fora_de_ordem);
+    CONFERIR(!rasgado);
+    // Nenhum quadro some: ou foi apresentado, ou o consumidor o pulou por um mais novo
+    CONFERIR_IGUAL(apresentados + anel.pulados, NUM_QUADROS);
+    CONFERIR_IGUAL(anel.produzidos, NUM_QUADROS);
+    CONFERIR_IGUAL(anel.consumidos, NUM_QUADROS);
+}
+
+int main() {
+    testar_cheio_e_vazio();
+    testar_duas_threads();
+    return RESULTADO_TESTE();
+}
@@ -0,0 +1,186 @@
+// Debounce dos botões chamado direto, como a IRQ chamaria: trens de ressalto no aperto e na
+// soltura viram um evento só, descida e subida travadas juntas numa IRQ contam pelo nível
+// assentado, a fila cheia descarta e conta, e a janela quieta atravessa a volta do time_us_32.
+#include "botoes.h"
+#include "teste.h"
+
+#define PINO_A      5
+#define PINO_B      6
+#define ESTRANHO    22
+#define AMBAS       (BOTOES_DESCIDA | BOTOES_SUBIDA)
+
+static botoes_t botoes;
+static const uint8_t pinos[] = { PINO_A, PINO_B };
+
+// Uma borda sozinha na IRQ; o nível que a IRQ lê é o do fim da borda
+static void descida(unsigned int pino, uint32_t t) {
+    botoes_borda(&botoes, pino, BOTOES_DESCIDA, true, t);
+}
+
+static void subida(unsigned int pino, uint32_t t) {
+    botoes_borda(&botoes, pino, BOTOES_SUBIDA, false, t);
+}
+
+static uint32_t eventos_na_fila(uint8_t botao) {
+    uint32_t n = 0;
+    evento_botao_t evento;
+    while (botoes_proximo(&botoes, &evento)) {
+        CONFERIR_IGUAL(evento.botao, botao);
+        n++;
+    }
+    return n;
+}
+
+// Aperto com ressalto: contato, n voltas de 300 us e assenta apertado
+static uint32_t apertar_com_ressalto(unsigned int pino, uint32_t t, int voltas) {
+    descida(pino, t);
+    for (int i = 0; i < voltas; i++) {
+        subida(pino, t += 300);
+        descida(pino, t += 300);
+    }
+    return t;
+}
+
+// Soltura com ressalto: sobe, n voltas de 300 us e assenta solto
+static uint32_t soltar_com_ressalto(unsigned int pino, uint32_t t, int voltas) {
+    subida(pino, t);
+    for (int i = 0; i < voltas; i++) {
+        descida(pino, t += 300);
+        subida(pino, t += 300);
+    }
+    return t;
+}
+
+static void testar_ressaltos(void) {
+    uint32_t t = 1000000;
+    botoes_iniciar(&botoes, pinos, 2, t);
+
+    // O primeiro contato logo após iniciar já vale; as voltas do aperto não
+    t = apertar_com_ressalto(PINO_A, t, 4);
+    CONFERIR_IGUAL(eventos_na_fila(0), 1);
+    CONFERIR_IGUAL(botoes.ressaltos, 4);
+
+    // Soltura com ressalto depois de segurar: nenhuma descida dela é aperto
+    t = soltar_com_ressalto(PINO_A, t + 100000, 4);
+    CONFERIR_IGUAL(eventos_na_fila(0), 0);
+    CONFERIR_IGUAL(botoes.ressaltos, 8);
+
+    // Outro aperto depois da janela quieta vale de novo
+    t = apertar_com_ressalto(PINO_A, t + BOTOES_QUIETO_US, 2);
+    CONFERIR_IGUAL(eventos_na_fila(0), 1);
+    t = soltar_com_ressalto(PINO_A, t + 50000, 0);
+
+    // Aperto curto demais para a janela: a segunda descida ainda é ressalto
+    descida(PINO_A, t += BOTOES_QUIETO_US);
+    subida(PINO_A, t += 5000);
+    descida(PINO_A, t += 5000);
+    subida(PINO_A, t += 5000);
+    CONFERIR_IGUAL(eventos_na_fila(0), 1);
+
+    // A janela é por pino: o B aperta no meio do ressalto do A
+    t += BOTOES_QUIETO_US;
+    descida(PINO_A, t);
+    descida(PINO_B, t + 100);
+    subida(PINO_A, t + 200);
+    descida(PINO_A, t + 400);
+    evento_botao_t evento;
+    CONFERIR(botoes_proximo(&botoes, &evento) && evento.botao == 0 && evento.tempo_us == t);
+    CONFERIR(botoes_proximo(&botoes, &evento) && evento.botao == 1 && evento.tempo_us == t + 100);
+    CONFERIR(!botoes_proximo(&botoes, &evento));
+
+    // Pino que não é botão não mexe em nada
+    uint32_t bordas = botoes.bordas;
+    descida(ESTRANHO, t + 500000);
+    CONFERIR_IGUAL(botoes.bordas, bordas);
+    CONFERIR(!botoes_pendentes(&botoes));
+}
+
+// O ressalto trava as duas bordas antes de a IRQ ser atendida
+static void testar_bordas_juntas(void) {
+    uint32_t t = 5000000;
+    botoes_iniciar(&botoes, pinos, 2, t);
+
+    // Contato com as duas bordas numa IRQ só, lida já apertada: é o aperto
+    botoes_borda(&botoes, PINO_A, AMBAS, true, t);
+    descida(PINO_A, t + 600);
+    CONFERIR_IGUAL(eventos_na_fila(0), 1);
+
+    // O mesmo, mas a IRQ lê o pino no alto do ressalto: ainda é o aperto, e a descida
+    // que assenta depois é ressalto
+    subida(PINO_A, t += 100000);
+    botoes_borda(&botoes, PINO_A, AMBAS, false, t += BOTOES_QUIETO_US);
+    descida(PINO_A, t + 400);
+    CONFERIR_IGUAL(eventos_na_fila(0), 1);
+
+    // Só a descida travada, com o pino já de volta no alto: também é o aperto
+    subida(PINO_A, t += 100000);
+    botoes_borda(&botoes, PINO_A, BOTOES_DESCIDA, false, t += BOTOES_QUIETO_US);
+    subida(PINO_A, t + 200);
+    descida(PINO_A, t + 500);
+    CONFERIR_IGUAL(eventos_na_fila(0), 1);
+
+    // Soltura com as duas bordas juntas e o pino lido baixo no meio do ressalto: não é aperto
+    botoes_borda(&botoes, PINO_A, AMBAS, true, t += 100000);
+    subida(PINO_A, t + 300);
+    CONFERIR_IGUAL(eventos_na_fila(0), 0);
+
+    // Um clique inteiro dentro de um atendimento ainda é um aperto
+    botoes_borda(&botoes, PINO_B, AMBAS, false, t += BOTOES_QUIETO_US);
+    CONFERIR_IGUAL(eventos_na_fila(1), 1);
+}
+
+static void testar_fila_cheia(void) {
+    uint32_t t = 9000000;
+    botoes_iniciar(&botoes, pinos, 2, t);
+    for (int i = 0; i < BOTOES_FILA + 3; i++) {
+        descida(PINO_B, t);
+        subida(PINO_B, t + 50000);
+        t += 100000;
+    }
+    CONFERIR_IGUAL(botoes.descartados, 3);
+
+    // Os que entraram saem em ordem, e a fila volta a aceitar
+    evento_botao_t evento;
+    uint32_t esperado = 9000000;
+    for (int i = 0; i < BOTOES_FILA; i++) {
+        CONFERIR(botoes_proximo(&botoes, &evento) && evento.tempo_us == esperado);
+        esperado += 100000;
+    }
+    CONFERIR(!botoes_proximo(&botoes, &evento));
+    descida(PINO_B, t);
+    CONFERIR_IGUAL(eventos_na_fila(1), 1);
+    CONFERIR_IGUAL(botoes.descartados, 3);
+}
+
+// time_us_32 volta a zero a cada 71 minutos: a janela é uma diferença sem sinal
+static void testar_volta_do_relogio(void) {
+    uint32_t t = 0xFFFFFFFFu - 1000;
+    botoes_iniciar(&botoes, pinos, 2, t);
+    descida(PINO_A, t);
+    CONFERIR_IGUAL(eventos_na_fila(0), 1);
+
+    // Ressalto atravessando o zero
+    subida(PINO_A, t + 800);
+    descida(PINO_A, t + 1200);
+    CONFERIR_IGUAL(eventos_na_fila(0), 0);
+    CONFERIR_IGUAL(botoes.ressaltos, 1);
+
+    // Solta e aperta de novo já do outro lado do zero
+    subida(PINO_A, t + 50000);
+    descida(PINO_A, t + 50000 + BOTOES_QUIETO_US);
+    evento_botao_t evento;
+    CONFERIR(botoes_proximo(&botoes, &evento) && evento.tempo_us == t + 50000 + BOTOES_QUIETO_US);
+
+    // Iniciado perto do zero: o primeiro aperto continua valendo
+    botoes_iniciar(&botoes, pinos, 2, 100);
+    descida(PINO_B, 200);
+    CONFERIR_IGUAL(eventos_na_fila(1), 1);
+}
+
+int main(void) {
+    testar_ressaltos();
+    testar_bordas_juntas();
+    testar_fila_cheia();
+    testar_volta_do_relogio();
+    return RESULTADO_TESTE();
+}
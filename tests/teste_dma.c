@@ -0,0 +1,83 @@
+// Envio assíncrono do SSD1306 pelo DMA na HAL simulada: o que se desenha durante uma
+// transferência fica no back buffer e nunca chega ao quadro em voo. A simulação entrega os
+// bytes ao painel no disparo e confere, no fim da transferência, se alguém mudou a origem
+// (tx_words) no meio; é essa conferência que pega um envio que remonte o fluxo cedo demais.
+#include <string.h>
+#include "pico/stdlib.h"
+#include "hardware/i2c.h"
+#include "ssd1306.h"
+#include "sim.h"
+#include "teste.h"
+
+#define LARGURA_TELA   128
+#define ALTURA_TELA    64
+#define ENDERECO_OLED  0x3C
+#define BYTES_TELA     (LARGURA_TELA * ALTURA_TELA / 8)
+
+static ssd1306_t tela;
+
+static void guardar_quadro(uint8_t *quadro) {
+    memcpy(quadro, &tela.ram_buffer[1], BYTES_TELA);
+}
+
+static bool painel_mostra(const uint8_t *quadro) {
+    return memcmp(sim_oled()->gram, quadro, BYTES_TELA) == 0;
+}
+
+int main(void) {
+    static uint8_t quadro_a[BYTES_TELA], quadro_b[BYTES_TELA], quadro_c[BYTES_TELA];
+    sim_reiniciar();
+    i2c_init(i2c1, 400000);
+    ssd1306_init(&tela, LARGURA_TELA, ALTURA_TELA, false, ENDERECO_OLED, i2c1);
+    CONFERIR(ssd1306_config(&tela));
+    CONFERIR(ssd1306_init_dma(&tela));
+
+    // Quadro A inteiro em voo: o DMA fica ocupado pelo tempo de fio de ~1 KB
+    ssd1306_fill(&tela, false);
+    ssd1306_fill_rect(&tela, 0, 0, 64, 32, true);
+    ssd1306_draw_string(&tela, "QUADRO A", 70, 40, false);
+    guardar_quadro(quadro_a);
+    ssd1306_send_data_async(&tela);
+    CONFERIR(ssd1306_busy(&tela));
+
+    // O quadro B é desenhado por cima enquanto A sai; o front buffer continua sendo A
+    ssd1306_fill(&tela, false);
+    ssd1306_fill_rect(&tela, 64, 32, 64, 32, true);
+    sleep_us(5000);
+    CONFERIR(ssd1306_busy(&tela));
+    ssd1306_draw_string(&tela, "QUADRO B", 2, 8, false);
+    guardar_quadro(quadro_b);
+    CONFERIR(memcmp(tela.front_buffer, quadro_a, BYTES_TELA) == 0);
+
+    ssd1306_wait(&tela);
+    CONFERIR(!ssd1306_busy(&tela));
+    CONFERIR(painel_mostra(quadro_a));
+    CONFERIR_IGUAL(sim_estatisticas()->dma_origem_alterada, 0);
+
+    // B sai em janelas, e o C pedido logo atrás espera B terminar antes de remontar tx_words
+    ssd1306_send_data_async(&tela);
+    CONFERIR(ssd1306_busy(&tela));
+    CONFERIR(memcmp(tela.front_buffer, quadro_b, BYTES_TELA) == 0);
+    ssd1306_fill_rect(&tela, 30, 10, 20, 20, false);
+    guardar_quadro(quadro_c);
+    ssd1306_send_data_async(&tela);
+    CONFERIR(painel_mostra(quadro_c));
+    CONFERIR(memcmp(tela.front_buffer, quadro_c, BYTES_TELA) == 0);
+
+    // Comandos também esperam a vez: o contraste só entra depois dos dados de C
+    ssd1306_contrast(&tela, 0x20);
+    CONFERIR(!ssd1306_busy(&tela));
+    CONFERIR_IGUAL(sim_oled()->contraste, 0x20);
+    CONFERIR_IGUAL(sim_estatisticas()->dma_origem_alterada, 0);
+    CONFERIR(painel_mostra(quadro_c));
+    CONFERIR_IGUAL(tela.bus_errors, 0);
+
+    // Controle: mexer em tx_words com o DMA ocupado é o que a simulação acusa
+    ssd1306_fill(&tela, true);
+    ssd1306_send_data_async(&tela);
+    CONFERIR(ssd1306_busy(&tela));
+    tela.tx_words[100] ^= 0xFF;
+    ssd1306_wait(&tela);
+    CONFERIR(sim_estatisticas()->dma_origem_alterada > 0);
+    return RESULTADO_TESTE();
+}
@@ -0,0 +1,132 @@
+// framebuffer.h contra o driver de geometria em tempo de execução: a mesma sequência
+// sorteada de pixel, fill_rect e fill em cada geometria tem que deixar os mesmos pixels e as
+// mesmas faixas sujas que ssd1306_pixel/ssd1306_fill_rect/ssd1306_fill. No SH1106 a
+// referência é um ssd1306_t de 132 colunas com o desenho recortado em 128 e deslocado em 2.
+// Com --geometria-errada desenha pela fachada do SH1106 num ssd1306_t de 128 colunas, que o
+// assert do construtor tem que parar antes de escrever fora do buffer.
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "framebuffer.h"
+#include "ssd1306.h"
+#include "teste.h"
+
+#define OPERACOES       20000
+#define LIMPAR_A_CADA   50       // Operações entre um envio (sujeira zerada) e outro
+#define ENDERECO_OLED   0x3C
+
+typedef struct {
+    const char *nome;
+    uint8_t colunas, altura, deslocamento;
+    void (*pixel)(ssd1306_t *, int, int, bool);
+    void (*fill)(ssd1306_t *, bool);
+    void (*fill_rect)(ssd1306_t *, int, int, int, int, bool);
+} geometria_t;
+
+static const geometria_t geometrias[] = {
+    { "128x64", 128, 64, 0, framebuffer_128x64_pixel, framebuffer_128x64_fill, framebuffer_128x64_fill_rect },
+    { "128x32", 128, 32, 0, framebuffer_128x32_pixel, framebuffer_128x32_fill, framebuffer_128x32_fill_rect },
+    { "sh1106", 132, 64, 2, framebuffer_sh1106_pixel, framebuffer_sh1106_fill, framebuffer_sh1106_fill_rect },
+};
+
+static uint32_t estado_sorteio = 0x2545F491u;
+
+// Inteiro em [minimo, maximo)
+static int sortear(int minimo, int maximo) {
+    estado_sorteio ^= estado_sorteio << 13;
+    estado_sorteio ^= estado_sorteio >> 17;
+    estado_sorteio ^= estado_sorteio << 5;
+    return minimo + (int)(estado_sorteio % (uint32_t)(maximo - minimo));
+}
+
+static void limpar_sujeira(ssd1306_t *ssd) {
+    std::memset(ssd->dirty_min, 0xFF, sizeof(ssd->dirty_min));
+    std::memset(ssd->dirty_max, 0x00, sizeof(ssd->dirty_max));
+}
+
+static bool iguais(const ssd1306_t *a, const ssd1306_t *b) {
+    return std::memcmp(a->ram_buffer, b->ram_buffer, a->bufsize) == 0 &&
+           std::memcmp(a->dirty_min, b->dirty_min, sizeof(a->dirty_min)) == 0 &&
+           std::memcmp(a->dirty_max, b->dirty_max, sizeof(a->dirty_max)) == 0;
+}
+
+// Referência pelo driver; a área visível tem 128 colunas a partir do deslocamento
+static void referencia_pixel(ssd1306_t *ssd, const geometria_t *g, int x, int y, bool valor) {
+    if (x < 0 || x >= 128) return;
+    ssd1306_pixel(ssd, (uint8_t)(x + g->deslocamento), (uint8_t)y, valor);
+}
+
+static void referencia_fill_rect(ssd1306_t *ssd, const geometria_t *g, int x, int y, int w, int h, bool valor) {
+    if (x < 0) { w += x; x = 0; }
+    if (x + w > 128) w = 128 - x;
+    if (w <= 0) return;
+    ssd1306_fill_rect(ssd, x + g->deslocamento, y, w, h, valor);
+}
+
+static void testar(const geometria_t *g) {
+    ssd1306_t rapido, referencia;
+    ssd1306_init(&rapido, g->colunas, g->altura, false, ENDERECO_OLED, i2c1);
+    ssd1306_init(&referencia, g->colunas, g->altura, false, ENDERECO_OLED, i2c1);
+
+    int divergencias = 0;
+    for (int i = 0; i < OPERACOES && divergencias < 5; i++) {
+        if (i % LIMPAR_A_CADA == 0) {
+            limpar_sujeira(&rapido);
+            limpar_sujeira(&referencia);
+        }
+        bool valor = sortear(0, 2);
+        int operacao = sortear(0, 200);
+        if (operacao == 0) {
+            g->fill(&rapido, valor);
+            ssd1306_fill(&referencia, valor);
+        } else if (operacao < 100) {
+            // Inclui os dois lados de fora da tela; o driver recebe uint8_t, então nada passa de 255
+            int x = sortear(-10, 200), y = sortear(-10, g->altura + 10);
+            g->pixel(&rapido, x, y, valor);
+            if (y >= 0) referencia_pixel(&referencia, g, x, y, valor);
+        } else {
+            int x = sortear(-20, 150), y = sortear(-20, g->altura + 10);
+            int w = sortear(-5, 80), h = sortear(-5, g->altura + 10);
+            g->fill_rect(&rapido, x, y, w, h, valor);
+            referencia_fill_rect(&referencia, g, x, y, w, h, valor);
+        }
+        if (!iguais(&rapido, &referencia)) {
+            std::fprintf(stderr, "%s: operação %d diverge\n", g->nome, i);
+            divergencias++;
+            std::memcpy(rapido.ram_buffer, referencia.ram_buffer, referencia.bufsize);
+            std::memcpy(rapido.dirty_min, referencia.dirty_min, sizeof(referencia.dirty_min));
+            std::memcpy(rapido.dirty_max, referencia.dirty_max, sizeof(referencia.dirty_max));
+        }
+    }
+    CONFERIR_IGUAL(divergencias, 0);
+
+    // O SH1106 nunca escreve nas duas colunas de cada lado que o painel não mostra
+    if (g->deslocamento) {
+        g->fill(&rapido, false);
+        g->fill_rect(&rapido, -50, -50, 400, 400, true);
+        for (unsigned p = 0; p < rapido.pages; p++) {
+            const uint8_t *linha = &rapido.ram_buffer[1 + p * g->colunas];
+            CONFERIR(linha[0] == 0 && linha[1] == 0 && linha[2] == 0xFF);
+            CONFERIR(linha[129] == 0xFF && linha[130] == 0 && linha[131] == 0);
+        }
+    }
+}
+
+// O abort do assert é o resultado esperado
+static void parou_no_assert(int) {
+    std::_Exit(0);
+}
+
+int main(int argc, char **argv) {
+    if (argc == 2 && std::strcmp(argv[1], "--geometria-errada") == 0) {
+        ssd1306_t estreito;
+        ssd1306_init(&estreito, 128, 64, false, ENDERECO_OLED, i2c1);
+        std::signal(SIGABRT, parou_no_assert);
+        framebuffer_sh1106_fill(&estreito, true);
+        std::fprintf(stderr, "fachada do SH1106 desenhou num buffer de 128 colunas\n");
+        return 1;
+    }
+    for (const geometria_t &g : geometrias) testar(&g);
+    return RESULTADO_TESTE();
+}
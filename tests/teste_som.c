@@ -0,0 +1,89 @@
+// Fila de notas dos buzzers contra o timer simulado: cada nota soa pelo tempo pedido, a fila
+// termina em silêncio com o canal livre, e uma nota de 0 ms é pulada sem travar o canal.
+#include "pico/stdlib.h"
+#include "som.h"
+#include "sim.h"
+#include "teste.h"
+
+#define BUZZER_A 21
+#define BUZZER_B 10
+
+static uint64_t inicio_us;
+
+// Dorme até t_us depois do início da fila
+static void ate(uint64_t t_us) {
+    uint64_t alvo = inicio_us + t_us;
+    if (sim_agora_us() < alvo) sleep_us(alvo - sim_agora_us());
+}
+
+static bool soando(unsigned int pino) {
+    return sim_pwm_nivel(pino) != 0;
+}
+
+// Topo do contador PWM que o canal 0 usa para a frequência
+static uint16_t topo_de(uint16_t frequencia_hz) {
+    inicio_us = sim_agora_us();
+    som_tocar(0, frequencia_hz, 10);
+    ate(5000);
+    uint16_t topo = sim_pwm_topo(BUZZER_A);
+    ate(20000);
+    return topo;
+}
+
+int main(void) {
+    sim_reiniciar();
+    som_iniciar(BUZZER_A, BUZZER_B);
+    CONFERIR(!som_ocupado(0) && !soando(BUZZER_A));
+
+    // Uma nota: soa 100 ms em 50% do período e para sozinha
+    inicio_us = sim_agora_us();
+    CONFERIR(som_tocar(0, 1000, 100));
+    CONFERIR(som_ocupado(0));
+    ate(1);
+    CONFERIR(soando(BUZZER_A));
+    CONFERIR_IGUAL(sim_pwm_nivel(BUZZER_A), sim_pwm_topo(BUZZER_A) / 2);
+    CONFERIR(!soando(BUZZER_B));
+    ate(99999);
+    CONFERIR(som_ocupado(0) && soando(BUZZER_A));
+    ate(100001);
+    CONFERIR(!som_ocupado(0) && !soando(BUZZER_A));
+
+    // Nota de 0 ms sozinha: nada soa e o canal fica livre
+    inicio_us = sim_agora_us();
+    CONFERIR(som_tocar(0, 1000, 0));
+    ate(1000);
+    CONFERIR(!som_ocupado(0) && !soando(BUZZER_A));
+
+    // Nota de 0 ms no meio: a seguinte entra no lugar dela, sem somar tempo
+    uint16_t topo_440 = topo_de(440), topo_660 = topo_de(660);
+    CONFERIR(topo_440 != topo_660);
+    static const nota_t com_vazia[] = { { 440, 50 }, { 880, 0 }, { 660, 50 } };
+    inicio_us = sim_agora_us();
+    CONFERIR(som_enfileirar(0, com_vazia, 3));
+    ate(25000);
+    CONFERIR(soando(BUZZER_A));
+    CONFERIR_IGUAL(sim_pwm_topo(BUZZER_A), topo_440);
+    ate(75000);
+    CONFERIR(soando(BUZZER_A));
+    CONFERIR_IGUAL(sim_pwm_topo(BUZZER_A), topo_660);
+    ate(100001);
+    CONFERIR(!som_ocupado(0) && !soando(BUZZER_A));
+
+    // Notas seguidas terminam no prazo somado, sem atraso acumulado, com pausas (0 Hz) mudas
+    static const nota_t jingle[] = { { 523, 30 }, { 0, 30 }, { 659, 30 }, { 0, 30 },
+                                     { 784, 30 }, { 0, 30 }, { 1047, 30 }, { 0, 0 } };
+    inicio_us = sim_agora_us();
+    CONFERIR(som_enfileirar(1, jingle, 8));
+    ate(45000);
+    CONFERIR(!soando(BUZZER_B));
+    ate(209999);
+    CONFERIR(som_ocupado(1));
+    ate(210001);
+    CONFERIR(!som_ocupado(1) && !soando(BUZZER_B));
+
+    // Os dois canais continuam aceitando notas
+    CONFERIR(som_tocar(0, 500, 10) && som_tocar(1, 500, 10));
+    sleep_ms(20);
+    CONFERIR(!som_ocupado(0) && !som_ocupado(1));
+    return RESULTADO_TESTE();
+}
@@ -0,0 +1,128 @@
+// sprite_draw contra o desenho pixel a pixel por ssd1306_pixel, em sprites, máscaras e
+// posições sorteados: x e y negativos, y fora do alinhamento de página, recorte nas quatro
+// bordas, última página do sprite pela metade, vários quadros e a volta do índice de quadro.
+// A imagem tem que ser a mesma; as faixas sujas do sprite cobrem as da referência sem sair
+// das colunas recortadas.
+#include <stdio.h>
+#include <string.h>
+#include "hardware/i2c.h"
+#include "sprite.h"
+#include "ssd1306.h"
+#include "teste.h"
+
+#define CASOS          200000
+#define MAX_LARGURA    16
+#define MAX_ALTURA     20
+#define MAX_QUADROS    3
+#define ENDERECO_OLED  0x3C
+
+static uint32_t estado_sorteio = 0x9E3779B9u;
+
+// Inteiro em [minimo, maximo)
+static int sortear(int minimo, int maximo) {
+    estado_sorteio ^= estado_sorteio << 13;
+    estado_sorteio ^= estado_sorteio >> 17;
+    estado_sorteio ^= estado_sorteio << 5;
+    return minimo + (int)(estado_sorteio % (uint32_t)(maximo - minimo));
+}
+
+static bool bit(const uint8_t *quadro, int largura, int coluna, int linha) {
+    return quadro[(linha >> 3) * largura + coluna] & (1u << (linha & 7));
+}
+
+static void limpar_sujeira(ssd1306_t *ssd) {
+    memset(ssd->dirty_min, 0xFF, sizeof(ssd->dirty_min));
+    memset(ssd->dirty_max, 0x00, sizeof(ssd->dirty_max));
+}
+
+static void referencia(ssd1306_t *ssd, const sprite_t *s, uint8_t quadro, int x, int y) {
+    int bytes = SPRITE_FRAME_BYTES(s->width, s->height);
+    int indice = s->frames ? quadro % s->frames : 0;
+    const uint8_t *pixels = s->pixels + indice * bytes;
+    const uint8_t *mascara = s->mask ? s->mask + indice * bytes : NULL;
+    for (int c = 0; c < s->width; c++) {
+        for (int l = 0; l < s->height; l++) {
+            int px = x + c, py = y + l;
+            if (px < 0 || px >= ssd->width || py < 0 || py >= ssd->height) continue;
+            if (mascara && !bit(mascara, s->width, c, l)) continue;
+            ssd1306_pixel(ssd, (uint8_t)px, (uint8_t)py, bit(pixels, s->width, c, l));
+        }
+    }
+}
+
+// Cada página suja na referência está suja no sprite, pelo menos nas mesmas colunas, e o
+// sprite não suja nada fora das colunas visíveis nem das páginas que ele cobre
+static bool sujeira_coerente(const ssd1306_t *rapido, const ssd1306_t *ref, const sprite_t *s, int x, int y) {
+    int primeira = x < 0 ? 0 : x, ultima = x + s->width - 1;
+    if (ultima >= rapido->width) ultima = rapido->width - 1;
+    for (int p = 0; p < rapido->pages; p++) {
+        bool suja = rapido->dirty_min[p] <= rapido->dirty_max[p];
+        if (ref->dirty_min[p] <= ref->dirty_max[p]) {
+            if (!suja || rapido->dirty_min[p] > ref->dirty_min[p] || rapido->dirty_max[p] < ref->dirty_max[p]) return false;
+        }
+        if (!suja) continue;
+        if (p * 8 + 7 < y || p * 8 >= y + s->height) return false;
+        if (rapido->dirty_min[p] < primeira || rapido->dirty_max[p] > ultima) return false;
+    }
+    return true;
+}
+
+static void testar_sorteados(ssd1306_t *rapido, ssd1306_t *ref) {
+    static uint8_t pixels[MAX_QUADROS * SPRITE_FRAME_BYTES(MAX_LARGURA, MAX_ALTURA)];
+    static uint8_t mascara[sizeof(pixels)];
+    int divergencias = 0;
+
+    for (int caso = 0; caso < CASOS && divergencias < 5; caso++) {
+        sprite_t s = { (uint8_t)sortear(1, MAX_LARGURA + 1), (uint8_t)sortear(1, MAX_ALTURA + 1),
+                       (uint8_t)sortear(1, MAX_QUADROS + 1), pixels, NULL };
+        for (size_t i = 0; i < sizeof(pixels); i++) {
+            pixels[i] = (uint8_t)sortear(0, 256);
+            mascara[i] = (uint8_t)sortear(0, 256);
+        }
+        // Sem máscara, máscara própria, ou transparente onde o sprite é apagado
+        int tipo_mascara = sortear(0, 3);
+        if (tipo_mascara == 1) s.mask = mascara;
+        if (tipo_mascara == 2) s.mask = pixels;
+
+        // Fundo sorteado, igual nos dois
+        for (uint16_t i = 1; i < rapido->bufsize; i++) rapido->ram_buffer[i] = (uint8_t)sortear(0, 256);
+        memcpy(ref->ram_buffer, rapido->ram_buffer, rapido->bufsize);
+        limpar_sujeira(rapido);
+        limpar_sujeira(ref);
+
+        int x = sortear(-MAX_LARGURA - 2, rapido->width + 2);
+        int y = sortear(-MAX_ALTURA - 2, rapido->height + 2);
+        uint8_t quadro = (uint8_t)sortear(0, 256);
+        sprite_draw(rapido, &s, quadro, x, y);
+        referencia(ref, &s, quadro, x, y);
+
+        if (memcmp(rapido->ram_buffer, ref->ram_buffer, rapido->bufsize) != 0 ||
+            !sujeira_coerente(rapido, ref, &s, x, y)) {
+            fprintf(stderr, "caso %d: %dx%d, %d quadros, máscara %d, quadro %d em (%d, %d) numa tela de %d linhas\n",
+                    caso, s.width, s.height, s.frames, tipo_mascara, quadro, x, y, rapido->height);
+            divergencias++;
+        }
+    }
+    CONFERIR_IGUAL(divergencias, 0);
+}
+
+int main(void) {
+    static ssd1306_t telas[2][2];   // [geometria][rápido, referência]
+    const uint8_t alturas[2] = { 64, 32 };
+    for (int g = 0; g < 2; g++) {
+        ssd1306_init(&telas[g][0], 128, alturas[g], false, ENDERECO_OLED, i2c1);
+        ssd1306_init(&telas[g][1], 128, alturas[g], false, ENDERECO_OLED, i2c1);
+        testar_sorteados(&telas[g][0], &telas[g][1]);
+    }
+
+    // Sprite montado à mão sem quadros: vale como um quadro só, em vez de dividir por zero
+    ssd1306_t *tela = &telas[0][0];
+    static const uint8_t cheio[SPRITE_FRAME_BYTES(4, 4)] = { 0x0F, 0x0F, 0x0F, 0x0F };
+    const sprite_t sem_quadros = { 4, 4, 0, cheio, NULL };
+    ssd1306_fill(tela, false);
+    sprite_draw(tela, &sem_quadros, 3, 10, 12);
+    CONFERIR_IGUAL(tela->ram_buffer[1 + 1 * 128 + 10], 0xF0);
+    CONFERIR_IGUAL(tela->ram_buffer[1 + 1 * 128 + 13], 0xF0);
+    CONFERIR_IGUAL(tela->ram_buffer[1 + 1 * 128 + 14], 0x00);
+    return RESULTADO_TESTE();
+}
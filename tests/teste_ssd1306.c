@@ -0,0 +1,104 @@
+// Bytes que cada envio do SSD1306 põe no I2C, contados pela HAL simulada: quadro sem mudança
+// não envia nada, um sprite que andou envia só as suas janelas, e acima de SSD1306_MAX_WINDOWS
+// janelas o envio vira um quadro inteiro. Depois de cada envio a GDDRAM do painel simulado tem
+// que ser igual ao back buffer.
+#include <string.h>
+#include "hardware/i2c.h"
+#include "ssd1306.h"
+#include "sim.h"
+#include "teste.h"
+
+#define LARGURA_TELA   128
+#define ALTURA_TELA    64
+#define ENDERECO_OLED  0x3C
+#define LADO_SPRITE    8
+
+// Cada transação leva o byte de endereço; os comandos vão atrás de um byte de controle
+#define BYTES_COMANDOS(n)  (1 + 1 + (n))
+#define BYTES_JANELA(largura) (BYTES_COMANDOS(6) + 1 + 1 + (largura))   // 0x21 e 0x22, depois os dados
+#define BYTES_QUADRO(ssd)  (BYTES_COMANDOS(6) + 1 + (ssd)->bufsize)     // ram_buffer já traz o controle
+
+static ssd1306_t tela;
+
+// Envia o back buffer e devolve os bytes que foram para o barramento
+static uint64_t enviar(void) {
+    uint64_t antes = sim_estatisticas()->i2c_bytes;
+    ssd1306_send_data(&tela);
+    return sim_estatisticas()->i2c_bytes - antes;
+}
+
+static bool painel_igual_ao_buffer(void) {
+    return memcmp(sim_oled()->gram, &tela.ram_buffer[1], tela.bufsize - 1) == 0;
+}
+
+static void mover_sprite(int x0, int y0, int x1, int y1) {
+    ssd1306_fill_rect(&tela, x0, y0, LADO_SPRITE, LADO_SPRITE, false);
+    ssd1306_fill_rect(&tela, x1, y1, LADO_SPRITE, LADO_SPRITE, true);
+}
+
+// Um pixel aceso em cada uma de n colunas, longe o bastante para nenhuma janela se juntar
+static void espalhar_pixels(int n, bool valor) {
+    int por_pagina = LARGURA_TELA / (SSD1306_WINDOW_OVERHEAD + 2) + 1;
+    for (int i = 0; i < n; i++) {
+        ssd1306_pixel(&tela, (uint8_t)((i % por_pagina) * (SSD1306_WINDOW_OVERHEAD + 2)),
+                      (uint8_t)((i / por_pagina) * 8), valor);
+    }
+}
+
+int main(void) {
+    sim_reiniciar();
+    i2c_init(i2c1, 400000);
+    ssd1306_init(&tela, LARGURA_TELA, ALTURA_TELA, false, ENDERECO_OLED, i2c1);
+    CONFERIR(ssd1306_config(&tela));
+
+    // Depois do config a GDDRAM é indefinida: o primeiro envio é sempre o quadro inteiro
+    ssd1306_fill(&tela, false);
+    CONFERIR_IGUAL(enviar(), BYTES_QUADRO(&tela));
+    CONFERIR(painel_igual_ao_buffer());
+
+    // Nada mudou, e redesenhar igual também não conta
+    CONFERIR_IGUAL(enviar(), 0);
+    ssd1306_fill(&tela, false);
+    CONFERIR_IGUAL(enviar(), 0);
+
+    // Sprite alinhado na página: a coluna que apagou e a que acendeu viram uma janela de 9 bytes
+    mover_sprite(-100, -100, 40, 16);
+    CONFERIR_IGUAL(enviar(), BYTES_JANELA(LADO_SPRITE));
+    mover_sprite(40, 16, 41, 16);
+    CONFERIR_IGUAL(enviar(), BYTES_JANELA(LADO_SPRITE + 1));
+    CONFERIR(painel_igual_ao_buffer());
+
+    // Fora do alinhamento ele ocupa duas páginas, uma janela em cada; ao descer, a página de
+    // baixo só ganha as colunas novas
+    mover_sprite(41, 16, 42, 20);
+    CONFERIR_IGUAL(enviar(), BYTES_JANELA(LADO_SPRITE + 1) + BYTES_JANELA(LADO_SPRITE));
+    mover_sprite(42, 20, 43, 20);
+    CONFERIR_IGUAL(enviar(), 2 * BYTES_JANELA(LADO_SPRITE + 1));
+    CONFERIR(painel_igual_ao_buffer());
+    mover_sprite(43, 20, -100, -100);
+    enviar();
+
+    // Exatamente SSD1306_MAX_WINDOWS janelas ainda vão uma a uma
+    espalhar_pixels(SSD1306_MAX_WINDOWS, true);
+    CONFERIR_IGUAL(enviar(), SSD1306_MAX_WINDOWS * BYTES_JANELA(1));
+    CONFERIR(painel_igual_ao_buffer());
+    espalhar_pixels(SSD1306_MAX_WINDOWS, false);
+    enviar();
+
+    // Uma a mais e sai o quadro inteiro
+    espalhar_pixels(SSD1306_MAX_WINDOWS + 1, true);
+    CONFERIR_IGUAL(enviar(), BYTES_QUADRO(&tela));
+    CONFERIR(painel_igual_ao_buffer());
+    CONFERIR_IGUAL(enviar(), 0);
+    CONFERIR_IGUAL(tela.bus_errors, 0);
+
+    // A configuração dos pinos COM depende da altura: com 0x12 um painel de 32 linhas pula uma sim, outra não
+    CONFERIR_IGUAL(sim_oled()->multiplex, ALTURA_TELA - 1);
+    CONFERIR_IGUAL(sim_oled()->pinos_com, 0x12);
+    static ssd1306_t tela_32;
+    ssd1306_init(&tela_32, LARGURA_TELA, 32, false, ENDERECO_OLED, i2c1);
+    CONFERIR(ssd1306_config(&tela_32));
+    CONFERIR_IGUAL(sim_oled()->multiplex, 31);
+    CONFERIR_IGUAL(sim_oled()->pinos_com, 0x02);
+    return RESULTADO_TESTE();
+}
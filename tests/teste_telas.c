@@ -0,0 +1,112 @@
+// Bytes de imagem que cada tela do jogo manda ao OLED, com o jogo inteiro rodando na HAL
+// simulada: abertura, pausa e game over são desenhadas uma vez e depois só recebem comandos
+// (contraste, inversão, rolagem); na partida cada quadro leva só o que mudou.
+//
+// Roteiro: B na abertura, partida com um trecho de movimento, pausa e volta pelo A, e o
+// joystick para a direita até o jogador gastar as vidas na borda.
+#include <stdio.h>
+#include "sim.h"
+#include "agendador.h"
+#include "teste.h"
+
+#define CANAL_ADC_X          1        // GPIO 27
+#define CENTRO_ADC           2048
+#define DESVIO_ADC           1000
+#define PINO_BOTAO_B         6
+#define PINO_BOTAO_A         5
+#define APERTO_US            50000
+#define ASSENTAR_US          200000   // Depois de entrar numa tela, o primeiro envio já saiu
+#define FIM_US               12000000
+#define BYTES_TELA           (128 * 64 / 8)
+
+int jogo_main(void);
+extern bool jogo_iniciado, jogo_pausado, fim_de_jogo;
+extern agendador_t agendador;
+
+typedef enum { ACAO_NADA, ACAO_APERTAR_B, ACAO_APERTAR_A, ACAO_DIREITA, ACAO_CENTRO } acao_t;
+
+// Em cada marca o gancho age e guarda o estado do jogo e do painel
+typedef struct {
+    uint64_t em_us;
+    acao_t acao;
+    uint32_t bytes_dados;
+    uint32_t renders;
+    bool iniciado, pausado, fim;
+} marca_t;
+
+enum {
+    ABERTURA_INICIO, ABERTURA_FIM,      // Abertura já desenhada, antes do B
+    JOGO_INICIO, JOGO_PARA, JOGO_FIM,   // Calibragem termina em 3,0 s
+    PAUSA_INICIO, PAUSA_FIM,
+    RUMO_A_BORDA,                       // A terceira batida na borda vem por volta de 9,7 s
+    GAME_OVER_INICIO, GAME_OVER_FIM,
+    NUM_MARCAS
+};
+
+static marca_t marcas[NUM_MARCAS] = {
+    [ABERTURA_INICIO] = { ASSENTAR_US, ACAO_NADA },
+    [ABERTURA_FIM] = { 1000000, ACAO_APERTAR_B },
+    [JOGO_INICIO] = { 3300000, ACAO_DIREITA },
+    [JOGO_PARA] = { 3600000, ACAO_CENTRO },
+    [JOGO_FIM] = { 5000000, ACAO_APERTAR_A },
+    [PAUSA_INICIO] = { 5000000 + ASSENTAR_US, ACAO_NADA },
+    [PAUSA_FIM] = { 6000000, ACAO_APERTAR_A },
+    [RUMO_A_BORDA] = { 6100000, ACAO_DIREITA },
+    [GAME_OVER_INICIO] = { 10500000, ACAO_NADA },
+    [GAME_OVER_FIM] = { FIM_US - 1000, ACAO_NADA },
+};
+static int proxima_marca;
+
+static void roteiro(uint64_t agora_us) {
+    while (proxima_marca < NUM_MARCAS && agora_us >= marcas[proxima_marca].em_us) {
+        marca_t *m = &marcas[proxima_marca++];
+        m->bytes_dados = sim_oled()->bytes_dados;
+        m->renders = agendador.renders;
+        m->iniciado = jogo_iniciado;
+        m->pausado = jogo_pausado;
+        m->fim = fim_de_jogo;
+        switch (m->acao) {
+            case ACAO_APERTAR_B: sim_pressionar(PINO_BOTAO_B, APERTO_US); break;
+            case ACAO_APERTAR_A: sim_pressionar(PINO_BOTAO_A, APERTO_US); break;
+            case ACAO_DIREITA: sim_definir_adc(CANAL_ADC_X, CENTRO_ADC + DESVIO_ADC); break;
+            case ACAO_CENTRO: sim_definir_adc(CANAL_ADC_X, CENTRO_ADC); break;
+            default: break;
+        }
+    }
+}
+
+static uint32_t bytes_entre(int de, int ate) {
+    return marcas[ate].bytes_dados - marcas[de].bytes_dados;
+}
+
+int main(void) {
+    sim_reiniciar();
+    sim_definir_gancho(roteiro);
+    sim_executar(jogo_main, FIM_US);
+    CONFERIR_IGUAL(proxima_marca, NUM_MARCAS);
+
+    // Abertura: o contraste pulsa e o letreiro corre sem nenhum byte de imagem
+    CONFERIR(!marcas[ABERTURA_FIM].iniciado);
+    CONFERIR(marcas[ABERTURA_INICIO].bytes_dados >= BYTES_TELA);
+    CONFERIR_IGUAL(bytes_entre(ABERTURA_INICIO, ABERTURA_FIM), 0);
+
+    // Partida: cada quadro leva as janelas do jogador e do pixel, bem menos que a tela
+    CONFERIR(marcas[JOGO_INICIO].iniciado && !marcas[JOGO_FIM].pausado && !marcas[JOGO_FIM].fim);
+    uint32_t quadros = marcas[JOGO_FIM].renders - marcas[JOGO_INICIO].renders;
+    uint32_t bytes_jogo = bytes_entre(JOGO_INICIO, JOGO_FIM);
+    printf("partida: %lu bytes de imagem em %lu quadros\n", (unsigned long)bytes_jogo, (unsigned long)quadros);
+    CONFERIR(quadros > 0);
+    CONFERIR(bytes_entre(JOGO_INICIO, JOGO_PARA) > 0);
+    CONFERIR(bytes_jogo < quadros * (BYTES_TELA / 16));
+
+    // Pausa: só o contraste cai, a imagem fica
+    CONFERIR(marcas[PAUSA_INICIO].pausado && marcas[PAUSA_FIM].pausado);
+    CONFERIR_IGUAL(bytes_entre(PAUSA_INICIO, PAUSA_FIM), 0);
+
+    // Game over: a inversão é comando; depois do primeiro envio nada mais de imagem
+    CONFERIR(!marcas[RUMO_A_BORDA].fim && marcas[GAME_OVER_INICIO].fim);
+    CONFERIR_IGUAL(bytes_entre(GAME_OVER_INICIO, GAME_OVER_FIM), 0);
+
+    CONFERIR_IGUAL(sim_oled()->dados_rolando, 0);
+    return RESULTADO_TESTE();
+}
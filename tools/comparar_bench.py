@@ -0,0 +1,129 @@
+#!/usr/bin/env python3
+"""Compara um resultado de bench_ssd1306 com a base guardada em bench/.
+
+O resultado pode ser o JSON gravado no host ou um log do monitor serial do
+dispositivo (linhas "#B "; vale o último relatório completo).
+
+Compara o mínimo das amostras, que o ruído de outros processos só aumenta,
+escalado pelo laço de referência ("ref") medido entre as amostras do mesmo
+kernel: uma máquina ou um clock mais lento deixa o kernel e a referência
+lentos na mesma proporção.
+Falha se algum kernel passar de limite x o mínimo da base e, além disso,
+ficar mais de piso_ns mais lento; o piso segura os kernels de poucos ns,
+em que um ciclo a mais já muda a razão. O limite e o piso vêm dos campos
+"limite" e "piso_ns" da base (padrão 1.25 e 10) ou de --limite e --piso.
+
+Uso: comparar_bench.py <resultado> <base.json> [--limite 1.25] [--piso 10]
+     comparar_bench.py <resultado>... <base.json> --atualizar [--limite 1.25] [--piso 10]
+     --atualizar grava uma nova base em vez de comparar. Com vários resultados,
+     cada kernel entra com a execução mediana, e não com a mais sortuda.
+"""
+import json
+import sys
+
+LIMITE_PADRAO = 1.25
+PISO_NS_PADRAO = 10.0
+PREFIXO_SERIAL = '#B '
+
+
+def ler_resultado(caminho):
+    texto = open(caminho, encoding='utf-8', errors='replace').read()
+    if texto.lstrip().startswith('{'):
+        return json.loads(texto)
+    relatorios, atual = [], []
+    for linha in texto.splitlines():
+        if not linha.startswith(PREFIXO_SERIAL):
+            continue
+        corpo = linha[len(PREFIXO_SERIAL):]
+        if corpo.startswith('{'):
+            atual = []
+        atual.append(corpo)
+        if corpo.startswith(']}'):
+            relatorios.append('\n'.join(atual))
+    if not relatorios:
+        sys.exit('nenhum relatório completo em %s' % caminho)
+    return json.loads(relatorios[-1])
+
+
+def opcao(args, nome):
+    if nome not in args:
+        return None
+    i = args.index(nome)
+    valor = float(args[i + 1])
+    del args[i:i + 2]
+    return valor
+
+
+def tempo(kernel):
+    # Bases antigas não têm o mínimo
+    return kernel.get('min', kernel['mediana'])
+
+
+def normalizado(kernel):
+    return tempo(kernel) / kernel['ref'] if 'ref' in kernel else tempo(kernel)
+
+
+def mediana_das_execucoes(resultados):
+    base = dict(resultados[0])
+    kernels = []
+    for kernel in resultados[0]['kernels']:
+        execucoes = [k for r in resultados for k in r['kernels'] if k['nome'] == kernel['nome']]
+        execucoes.sort(key=normalizado)
+        kernels.append(execucoes[len(execucoes) // 2])
+    base['kernels'] = kernels
+    return base
+
+
+def main():
+    args = sys.argv[1:]
+    atualizar = '--atualizar' in args
+    if atualizar:
+        args.remove('--atualizar')
+    limite = opcao(args, '--limite')
+    piso = opcao(args, '--piso')
+    if len(args) < 2 or (len(args) > 2 and not atualizar):
+        sys.exit(__doc__)
+
+    if atualizar:
+        resultado = mediana_das_execucoes([ler_resultado(caminho) for caminho in args[:-1]])
+        resultado['limite'] = limite or LIMITE_PADRAO
+        resultado['piso_ns'] = piso if piso is not None else PISO_NS_PADRAO
+        kernels = resultado.pop('kernels')
+        # Um kernel por linha, como o bench escreve, para a base gerar diffs legíveis
+        cabecalho = json.dumps(resultado, ensure_ascii=False)[:-1]
+        linhas = ',\n'.join('  ' + json.dumps(k, ensure_ascii=False) for k in kernels)
+        with open(args[-1], 'w', encoding='utf-8') as f:
+            f.write('%s, "kernels": [\n%s\n]}\n' % (cabecalho, linhas))
+        print('base atualizada: %s' % args[-1])
+        return
+
+    resultado = ler_resultado(args[0])
+    base = json.load(open(args[1], encoding='utf-8'))
+    limite = limite or base.get('limite', LIMITE_PADRAO)
+    if piso is None:
+        piso = base.get('piso_ns', PISO_NS_PADRAO)
+    if resultado.get('plataforma') != base.get('plataforma'):
+        sys.exit('plataformas diferentes: resultado %s, base %s' % (resultado.get('plataforma'), base.get('plataforma')))
+
+    medidos = {k['nome']: k for k in resultado['kernels']}
+    regressoes = 0
+    print('%-26s %12s %12s %8s' % ('kernel', 'base ns/op', 'agora ns/op', 'razão'))
+    for kernel in base['kernels']:
+        nome = kernel['nome']
+        if nome not in medidos:
+            print('%-26s %12.1f %12s %8s  AUSENTE' % (nome, tempo(kernel), '-', '-'))
+            regressoes += 1
+            continue
+        antes, agora = tempo(kernel), tempo(medidos[nome])
+        if 'ref' in kernel and 'ref' in medidos[nome]:
+            agora *= kernel['ref'] / medidos[nome]['ref']
+        razao = agora / antes
+        regrediu = razao > limite and agora - antes > piso
+        regressoes += regrediu
+        print('%-26s %12.1f %12.1f %8.2f  %s' % (nome, antes, agora, razao, 'REGRESSÃO' if regrediu else ''))
+    print('limite %.2fx e %.0f ns: %s' % (limite, piso, '%d regressão(ões)' % regressoes if regressoes else 'ok'))
+    sys.exit(1 if regressoes else 0)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,186 @@
+#!/usr/bin/env python3
+"""Compila os recursos gráficos de assets/ em tabelas const, já no formato dos drivers.
+
+Cada recurso é um PBM (P1 em texto ou P4 binário; 1 = pixel aceso) com os quadros
+empilhados na vertical e um comentário "# quadros N". O tipo vem da pasta:
+
+  assets/sprites/<nome>.pbm  sprite_t de sprite.h: colunas de 8 linhas por página, bit 0 em
+                             cima, e a própria imagem como máscara (pixel apagado = transparente)
+  assets/matriz/<nome>.pbm   padrões 5x5 da matriz WS2812: um uint32_t por quadro, bit i = LED i,
+                             com a linha de baixo da imagem nos LEDs 0 a 4
+
+Para cada recurso saem <saida>/<nome>.h e <nome>.c, e <saida>/recursos.txt lista os símbolos
+de cada recurso para tools/relatorio_assets.py.
+
+Uso: compilar_assets.py <saida> <recurso.pbm>...
+"""
+import os
+import re
+import sys
+
+LADO_MATRIZ = 5
+
+
+def ler_pbm(caminho):
+    dados = open(caminho, 'rb').read()
+    quadros = 1
+    tokens = []
+    posicao = 0
+    # Cabeçalho: número mágico, largura e altura, com comentários em qualquer lugar
+    while len(tokens) < 3:
+        m = re.compile(rb'\s*(#[^\n]*\n|\S+)').match(dados, posicao)
+        if not m:
+            sys.exit('%s: cabeçalho PBM incompleto' % caminho)
+        posicao = m.end()
+        token = m.group(1)
+        if token.startswith(b'#'):
+            q = re.match(rb'#\s*quadros\s+(\d+)', token)
+            if q:
+                quadros = int(q.group(1))
+            continue
+        tokens.append(token)
+    magico, largura, altura = tokens[0], int(tokens[1]), int(tokens[2])
+    if magico == b'P1':
+        corpo = re.sub(rb'#[^\n]*', b'', dados[posicao:])
+        bits = [int(b) for b in re.findall(rb'[01]', corpo)]
+    elif magico == b'P4':
+        bytes_linha = (largura + 7) // 8
+        corpo = dados[posicao + 1:]
+        bits = [(corpo[y * bytes_linha + x // 8] >> (7 - x % 8)) & 1 for y in range(altura) for x in range(largura)]
+    else:
+        sys.exit('%s: só PBM P1 ou P4' % caminho)
+    if len(bits) < largura * altura:
+        sys.exit('%s: faltam pixels' % caminho)
+    if altura % quadros:
+        sys.exit('%s: altura %d não divide em %d quadros' % (caminho, altura, quadros))
+    linhas = [bits[y * largura:(y + 1) * largura] for y in range(altura)]
+    return largura, altura // quadros, quadros, linhas
+
+
+def colunas_por_pagina(linhas, largura, altura):
+    saida = []
+    for pagina in range((altura + 7) // 8):
+        for x in range(largura):
+            byte = 0
+            for bit in range(8):
+                y = pagina * 8 + bit
+                if y < altura and linhas[y][x]:
+                    byte |= 1 << bit
+            saida.append(byte)
+    return saida
+
+
+def formatar(valores, formato):
+    return ', '.join(formato % v for v in valores)
+
+
+def cabecalho(origem):
+    return '// Gerado por tools/compilar_assets.py a partir de %s; não editar.' % origem
+
+
+def gerar_sprite(nome, origem, largura, altura, quadros, linhas):
+    simbolo = 'sprite_' + nome
+    macro = simbolo.upper()
+    h = [
+        cabecalho(origem),
+        '#ifndef %s_H' % macro,
+        '#define %s_H' % macro,
+        '',
+        '#include <stdint.h>',
+        '#include "sprite.h"',
+        '',
+        '#define %s_LARGURA %d' % (macro, largura),
+        '#define %s_ALTURA %d' % (macro, altura),
+        '#define %s_QUADROS %d' % (macro, quadros),
+        '',
+        'extern const uint8_t %s_pixels[%s_QUADROS * SPRITE_FRAME_BYTES(%s_LARGURA, %s_ALTURA)];' % (simbolo, macro, macro, macro),
+        'extern const sprite_t %s;' % simbolo,
+        '',
+        '#endif // %s_H' % macro,
+        '',
+    ]
+    c = [
+        cabecalho(origem),
+        '#include "%s.h"' % nome,
+        '',
+        'const uint8_t %s_pixels[%s_QUADROS * SPRITE_FRAME_BYTES(%s_LARGURA, %s_ALTURA)] = {' % (simbolo, macro, macro, macro),
+    ]
+    for quadro in range(quadros):
+        colunas = colunas_por_pagina(linhas[quadro * altura:(quadro + 1) * altura], largura, altura)
+        c.append('    %s, // quadro %d' % (formatar(colunas, '0x%02x'), quadro))
+    c += [
+        '};',
+        '',
+        'const sprite_t %s = { %s_LARGURA, %s_ALTURA, %s_QUADROS, %s_pixels, %s_pixels };' % (
+            simbolo, macro, macro, macro, simbolo, simbolo),
+        '',
+    ]
+    return h, c, [simbolo + '_pixels', simbolo]
+
+
+def gerar_matriz(nome, origem, largura, altura, quadros, linhas):
+    if largura != LADO_MATRIZ or altura != LADO_MATRIZ:
+        sys.exit('%s: quadros da matriz são %dx%d, não %dx%d' % (origem, LADO_MATRIZ, LADO_MATRIZ, largura, altura))
+    simbolo = 'matriz_' + nome
+    macro = simbolo.upper()
+    padroes = []
+    for quadro in range(quadros):
+        padrao = 0
+        imagem = linhas[quadro * altura:(quadro + 1) * altura]
+        for i, linha in enumerate(reversed(imagem)):
+            for x, aceso in enumerate(linha):
+                if aceso:
+                    padrao |= 1 << (i * largura + x)
+        padroes.append(padrao)
+    h = [
+        cabecalho(origem),
+        '#ifndef %s_H' % macro,
+        '#define %s_H' % macro,
+        '',
+        '#include <stdint.h>',
+        '',
+        '#define %s_QUADROS %d' % (macro, quadros),
+        '',
+        '// Bit i = LED i; a linha de baixo da imagem ocupa os LEDs 0 a 4',
+        'extern const uint32_t %s[%s_QUADROS];' % (simbolo, macro),
+        '',
+        '#endif // %s_H' % macro,
+        '',
+    ]
+    c = [
+        cabecalho(origem),
+        '#include "%s.h"' % nome,
+        '',
+        'const uint32_t %s[%s_QUADROS] = { %s };' % (simbolo, macro, formatar(padroes, '0x%07x')),
+        '',
+    ]
+    return h, c, [simbolo]
+
+
+GERADORES = {'sprites': gerar_sprite, 'matriz': gerar_matriz}
+
+
+def main():
+    if len(sys.argv) < 3:
+        sys.exit(__doc__)
+    saida = sys.argv[1]
+    os.makedirs(saida, exist_ok=True)
+    manifesto = []
+    for caminho in sys.argv[2:]:
+        tipo = os.path.basename(os.path.dirname(os.path.abspath(caminho)))
+        nome = os.path.splitext(os.path.basename(caminho))[0]
+        if tipo not in GERADORES:
+            sys.exit('%s: pasta "%s" não é assets/sprites nem assets/matriz' % (caminho, tipo))
+        origem = 'assets/%s/%s' % (tipo, os.path.basename(caminho))
+        h, c, simbolos = GERADORES[tipo](nome, origem, *ler_pbm(caminho))
+        with open(os.path.join(saida, nome + '.h'), 'w', encoding='utf-8') as f:
+            f.write('\n'.join(h))
+        with open(os.path.join(saida, nome + '.c'), 'w', encoding='utf-8') as f:
+            f.write('\n'.join(c))
+        manifesto.append('%s %s' % (nome, ' '.join(simbolos)))
+    with open(os.path.join(saida, 'recursos.txt'), 'w', encoding='utf-8') as f:
+        f.write('\n'.join(manifesto) + '\n')
+
+
+if __name__ == '__main__':
+    main()
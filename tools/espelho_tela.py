@@ -0,0 +1,172 @@
+#!/usr/bin/env python3
+"""Remonta o OLED a partir do espelho que vai junto com a telemetria.
+
+Com -DESPELHAR_TELA=ON o jogo manda, entre os registros de quadro, registros
+do tipo 2 com as páginas do OLED que mudaram, em XOR e RLE (layout em
+libs/Jogo_Bibliotecas/espelho.h). Uma página vai inteira a cada registro, em
+rodízio, então a imagem se acerta em 8 registros depois de conectar ou de um
+salto na sequência; até lá as páginas ainda sem chave aparecem como '?'.
+
+Sem -p desenha no terminal, no ritmo do tempo_ms dos registros de quadro
+quando lê de arquivo. Com -p grava cada tela recebida em PASTA/tela_NNNNN.pbm.
+
+Uso: espelho_tela.py [-p PASTA] <fluxo.bin | /dev/ttyACM0>
+     (na porta serial, configure antes com "stty -F /dev/ttyACM0 raw")
+"""
+import os
+import struct
+import sys
+import time
+
+from telemetria_csv import CABECALHO, REGISTRO, TIPO_QUADRO, cobs_decodificar
+
+TIPO_TELA = 2
+PAGINAS = 8
+LARGURA = 128
+CARGA_TELA = struct.Struct('<3B')
+
+
+def rle_decodificar(dados, i):
+    """Decodifica uma página a partir de dados[i]; devolve (bytes, próximo i) ou None."""
+    pagina = bytearray()
+    while len(pagina) < LARGURA:
+        if i >= len(dados):
+            return None
+        cabecalho = dados[i]
+        if cabecalho < 0x80:
+            pagina += dados[i + 1:i + 2 + cabecalho]
+            i += 2 + cabecalho
+        else:
+            if i + 1 >= len(dados):
+                return None
+            pagina += bytes([dados[i + 1]]) * (cabecalho - 0x80 + 3)
+            i += 2
+    return (pagina, i) if len(pagina) == LARGURA else None
+
+
+class Espelho:
+    def __init__(self):
+        self.tela = [bytearray(LARGURA) for _ in range(PAGINAS)]
+        self.acertadas = 0      # Máscara das páginas que já receberam chave desde o último salto
+        self.sequencia = None
+        self.telas = 0
+        self.perdidos = 0
+        self.tempo_ms = None
+
+    def registro(self, registro):
+        """Aplica um registro decodificado; devolve True se a tela mudou."""
+        tipo, sequencia = CABECALHO.unpack_from(registro)
+        if self.sequencia is not None and sequencia != (self.sequencia + 1) & 0xFFFFFFFF:
+            salto = (sequencia - self.sequencia - 1) & 0xFFFFFFFF
+            self.perdidos += salto
+            self.acertadas = 0
+            print('sequência %d -> %d: %d registro(s) perdido(s)' % (self.sequencia, sequencia, salto),
+                  file=sys.stderr)
+        self.sequencia = sequencia
+        if tipo == TIPO_QUADRO and len(registro) == REGISTRO.size:
+            self.tempo_ms = REGISTRO.unpack(registro)[2]
+            return False
+        if tipo != TIPO_TELA:
+            return False
+
+        carga = registro[CABECALHO.size:-1]
+        primeira, paginas, chaves = CARGA_TELA.unpack_from(carga)
+        i = CARGA_TELA.size
+        for k in range(PAGINAS):
+            p = (primeira + k) % PAGINAS
+            if not paginas & (1 << p):
+                continue
+            decodificada = rle_decodificar(carga, i)
+            if decodificada is None:
+                print('registro %d: página %d truncada' % (sequencia, p), file=sys.stderr)
+                self.acertadas = 0
+                return False
+            bytes_pagina, i = decodificada
+            if chaves & (1 << p):
+                self.tela[p][:] = bytes_pagina
+                self.acertadas |= 1 << p
+            else:
+                self.tela[p][:] = bytes(a ^ b for a, b in zip(self.tela[p], bytes_pagina))
+        self.telas += 1
+        return True
+
+    def pixel(self, x, y):
+        return self.tela[y // 8][x] >> (y % 8) & 1
+
+    def pbm(self):
+        linhas = bytearray()
+        for y in range(PAGINAS * 8):
+            for x0 in range(0, LARGURA, 8):
+                octeto = 0
+                for x in range(x0, x0 + 8):
+                    octeto = octeto << 1 | self.pixel(x, y)
+                linhas.append(octeto)
+        return b'P4\n%d %d\n' % (LARGURA, PAGINAS * 8) + bytes(linhas)
+
+    def texto(self):
+        """Duas linhas de pixels por linha de texto, com meios blocos."""
+        blocos = (' ', '▀', '▄', '█')
+        linhas = []
+        for y in range(0, PAGINAS * 8, 2):
+            if not self.acertadas & (1 << (y // 8)):
+                linhas.append('?' * LARGURA)
+                continue
+            linhas.append(''.join(blocos[self.pixel(x, y) | self.pixel(x, y + 1) << 1] for x in range(LARGURA)))
+        return '\n'.join(linhas)
+
+
+def registros(fluxo):
+    """Gera os registros válidos de qualquer tipo, na ordem do fluxo."""
+    pendente = b''
+    while True:
+        bloco = fluxo.read(4096)
+        if not bloco:
+            break
+        trechos = (pendente + bloco).split(b'\0')
+        pendente = trechos.pop()
+        for trecho in trechos:
+            registro = cobs_decodificar(trecho) if trecho else None
+            if registro is None or len(registro) <= CABECALHO.size or sum(registro) & 0xFF:
+                continue
+            yield registro
+
+
+def main():
+    argumentos = sys.argv[1:]
+    pasta = None
+    if len(argumentos) == 3 and argumentos[0] == '-p':
+        pasta = argumentos[1]
+        argumentos = argumentos[2:]
+    if len(argumentos) != 1:
+        sys.exit(__doc__)
+    if pasta:
+        os.makedirs(pasta, exist_ok=True)
+
+    espelho = Espelho()
+    with open(argumentos[0], 'rb', buffering=0) as fluxo:
+        ao_vivo = fluxo.isatty() or not os.path.isfile(argumentos[0])
+        inicio = None
+        try:
+            for registro in registros(fluxo):
+                if not espelho.registro(registro):
+                    continue
+                if pasta:
+                    with open(os.path.join(pasta, 'tela_%05d.pbm' % espelho.telas), 'wb') as saida:
+                        saida.write(espelho.pbm())
+                    continue
+                if not ao_vivo and espelho.tempo_ms is not None:
+                    if inicio is None:
+                        inicio = time.monotonic() - espelho.tempo_ms / 1000
+                    espera = inicio + espelho.tempo_ms / 1000 - time.monotonic()
+                    if espera > 0:
+                        time.sleep(espera)
+                sys.stdout.write('\x1b[H\x1b[2J' if espelho.telas == 1 else '\x1b[H')
+                sys.stdout.write(espelho.texto() + '\n')
+                sys.stdout.flush()
+        except KeyboardInterrupt:
+            pass
+    print('%d telas, %d registros perdidos' % (espelho.telas, espelho.perdidos), file=sys.stderr)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,53 @@
+#!/usr/bin/env python3
+"""Extrai uma gravação de entradas de um log do monitor serial.
+
+Com GRAVAR_ENTRADAS=1 o jogo escreve cada registro como uma linha "#G <hex>"
+no meio da saída normal. Cada partida começa num cabeçalho "BRG1" e só está
+completa depois do registro de fim (0x80).
+
+Uso: extrair_gravacao.py <log_serial> <saida.bin> [indice_partida]
+     (sem índice, usa a última partida completa; -1, -2... contam do fim)
+"""
+import sys
+
+MAGICA = b'BRG1'
+FIM = 0x80
+
+
+def partidas_completas(caminho):
+    partidas, atual = [], None
+    for linha in open(caminho, encoding='utf-8', errors='replace'):
+        # Um quadro de telemetria (terminado em 0x00) pode vir colado antes da linha
+        linha = linha.rsplit('\0', 1)[-1].strip()
+        if not linha.startswith('#G '):
+            continue
+        try:
+            registro = bytes.fromhex(linha[3:])
+        except ValueError:
+            atual = None  # Linha corrompida: a partida não é reproduzível
+            continue
+        if registro.startswith(MAGICA):
+            atual = bytearray(registro)
+        elif atual is not None:
+            atual += registro
+            if registro[0] == FIM:
+                partidas.append(bytes(atual))
+                atual = None
+    return partidas
+
+
+def main():
+    if len(sys.argv) not in (3, 4):
+        sys.exit(__doc__)
+    partidas = partidas_completas(sys.argv[1])
+    if not partidas:
+        sys.exit('nenhuma partida completa em %s' % sys.argv[1])
+    indice = int(sys.argv[3]) if len(sys.argv) == 4 else -1
+    with open(sys.argv[2], 'wb') as saida:
+        saida.write(partidas[indice])
+    print('%d partida(s) completa(s); gravada a %d (%d bytes)' % (
+        len(partidas), indice % len(partidas), len(partidas[indice])))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,112 @@
+#!/usr/bin/env python3
+"""Gera o atlas de glifos do SSD1306 a partir de font.h.
+
+O atlas fica na ordem de memória do display (um byte por coluna, bit n =
+linha n da página) e já com a rotação dos símbolos aplicada, para que o
+driver copie colunas inteiras em vez de desenhar pixel a pixel.
+
+Uso: gerar_atlas_fonte.py <font.h> <saida.h>
+"""
+import os
+import re
+import sys
+
+PRIMEIRO_CHAR = 32
+ULTIMO_CHAR = 126
+INDICE_NUMEROS_PEQUENOS = 68 * 8
+
+# Mesmo mapeamento que ssd1306_draw_char usava: caractere -> (glifo, rotacionado)
+SIMBOLOS = {':': 64, '.': 65, '>': 66, '-': 67}
+
+
+def ler_fonte(caminho):
+    texto = open(caminho, encoding='utf-8').read()
+    corpo = texto[texto.index('{') + 1:texto.rindex('}')]
+    corpo = re.sub(r'//[^\n]*', '', corpo)
+    return [int(v, 16) for v in re.findall(r'0x[0-9a-fA-F]+', corpo)]
+
+
+def glifo_do_char(c):
+    if '0' <= c <= '9':
+        return ord(c) - ord('0') + 1, False
+    if 'A' <= c <= 'Z':
+        return ord(c) - ord('A') + 11, False
+    if 'a' <= c <= 'z':
+        return ord(c) - ord('a') + 37, False
+    if c in SIMBOLOS:
+        return SIMBOLOS[c], True
+    return 0, False
+
+
+def colunas_do_glifo(fonte, glifo, rotacionado):
+    linhas = fonte[glifo * 8:glifo * 8 + 8]
+    if not rotacionado:
+        return linhas
+    # Símbolos são armazenados deitados: pixel (7 - j, i) = bit j da linha i
+    colunas = []
+    for coluna in range(8):
+        byte = 0
+        for i, linha in enumerate(linhas):
+            if (linha >> (7 - coluna)) & 1:
+                byte |= 1 << i
+        colunas.append(byte)
+    return colunas
+
+
+def colunas_numero_pequeno(fonte, digito):
+    linhas = fonte[INDICE_NUMEROS_PEQUENOS + digito * 5:INDICE_NUMEROS_PEQUENOS + digito * 5 + 5]
+    colunas = []
+    for coluna in range(5):
+        byte = 0
+        for i, linha in enumerate(linhas):
+            if (linha >> (4 - coluna)) & 1:
+                byte |= 1 << i
+        colunas.append(byte)
+    return colunas
+
+
+def formatar(colunas):
+    return ', '.join('0x%02x' % b for b in colunas)
+
+
+def main():
+    if len(sys.argv) != 3:
+        sys.exit(__doc__)
+    fonte = ler_fonte(sys.argv[1])
+
+    saida = [
+        '// Gerado por tools/gerar_atlas_fonte.py a partir de font.h; não editar.',
+        '#ifndef FONT_ATLAS_H',
+        '#define FONT_ATLAS_H',
+        '',
+        '#include <stdint.h>',
+        '',
+        '#define FONT_ATLAS_FIRST %d' % PRIMEIRO_CHAR,
+        '#define FONT_ATLAS_LAST %d' % ULTIMO_CHAR,
+        '#define FONT_ATLAS_WIDTH 8',
+        '#define FONT_ATLAS_SMALL_WIDTH 5',
+        '',
+        '// Colunas de cada caractere imprimível, bit 0 = linha superior',
+        'static const uint8_t font_atlas[FONT_ATLAS_LAST - FONT_ATLAS_FIRST + 1][FONT_ATLAS_WIDTH] = {',
+    ]
+    for codigo in range(PRIMEIRO_CHAR, ULTIMO_CHAR + 1):
+        c = chr(codigo)
+        glifo, rotacionado = glifo_do_char(c)
+        saida.append('    { %s }, // %r' % (formatar(colunas_do_glifo(fonte, glifo, rotacionado)), c))
+    saida += [
+        '};',
+        '',
+        '// Dígitos 5x5 usados por ssd1306_draw_small_number',
+        'static const uint8_t font_atlas_small[10][FONT_ATLAS_SMALL_WIDTH] = {',
+    ]
+    for digito in range(10):
+        saida.append('    { %s }, // %d' % (formatar(colunas_numero_pequeno(fonte, digito)), digito))
+    saida += ['};', '', '#endif // FONT_ATLAS_H', '']
+
+    os.makedirs(os.path.dirname(os.path.abspath(sys.argv[2])), exist_ok=True)
+    with open(sys.argv[2], 'w', encoding='utf-8') as f:
+        f.write('\n'.join(saida))
+
+
+if __name__ == '__main__':
+    main()
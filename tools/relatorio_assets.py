@@ -0,0 +1,78 @@
+#!/usr/bin/env python3
+"""Mostra quanto de flash e de RAM cada recurso gráfico ocupa no executável.
+
+Lê a tabela de símbolos com o nm (formato sysv, que traz a seção de cada símbolo) e soma,
+por recurso, os símbolos listados em recursos.txt de tools/compilar_assets.py e os passados
+como <recurso>=<símbolo>,<símbolo>. Tabelas em .rodata (ou .data.rel.ro, que no host guarda
+const com ponteiros) contam como flash; em .data ocupam flash e RAM; em .bss, só RAM.
+Sai com 1 se algum recurso ocupa RAM, porque aí faltou um const.
+
+Uso: relatorio_assets.py <nm> <executável> <recursos.txt> [<recurso>=<símbolo>,...]...
+"""
+import subprocess
+import sys
+
+
+def secao_ocupa(secao):
+    """(flash, ram) de um símbolo na seção."""
+    if secao.startswith('.rodata') or secao.startswith('.data.rel.ro') or secao.startswith('.text'):
+        return True, False
+    if secao.startswith('.data'):
+        return True, True
+    return False, True
+
+
+def ler_simbolos(nm, executavel):
+    saida = subprocess.run([nm, '-S', '--format=sysv', executavel], check=True,
+                           capture_output=True, text=True).stdout
+    simbolos = {}
+    for linha in saida.splitlines():
+        campos = [c.strip() for c in linha.split('|')]
+        if len(campos) < 7 or not campos[4]:
+            continue
+        simbolos[campos[0]] = (int(campos[4], 16), campos[6])
+    return simbolos
+
+
+def main():
+    if len(sys.argv) < 4:
+        sys.exit(__doc__)
+    nm, executavel, lista = sys.argv[1:4]
+    recursos = []
+    for linha in open(lista, encoding='utf-8'):
+        campos = linha.split()
+        if campos:
+            recursos.append((campos[0], campos[1:]))
+    for extra in sys.argv[4:]:
+        nome, simbolos = extra.split('=', 1)
+        recursos.append((nome, simbolos.split(',')))
+
+    simbolos = ler_simbolos(nm, executavel)
+    total_flash = total_ram = 0
+    em_ram = []
+    print('Recursos em %s:' % executavel.split('/')[-1])
+    for nome, nomes_simbolos in recursos:
+        flash = ram = 0
+        faltando = []
+        for simbolo in nomes_simbolos:
+            if simbolo not in simbolos:
+                faltando.append(simbolo)
+                continue
+            tamanho, secao = simbolos[simbolo]
+            na_flash, na_ram = secao_ocupa(secao)
+            flash += tamanho if na_flash else 0
+            ram += tamanho if na_ram else 0
+        total_flash += flash
+        total_ram += ram
+        if ram:
+            em_ram.append(nome)
+        nota = ' (fora do executável: %s)' % ', '.join(faltando) if faltando else ''
+        print('  %-12s %6d B de flash %6d B de RAM%s' % (nome, flash, ram, nota))
+    print('  %-12s %6d B de flash %6d B de RAM' % ('total', total_flash, total_ram))
+    if em_ram:
+        print('recursos em RAM (falta const?): %s' % ', '.join(em_ram), file=sys.stderr)
+        sys.exit(1)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,99 @@
+#!/usr/bin/env python3
+"""Decodifica o fluxo de telemetria binária do jogo em CSV.
+
+O jogo escreve no CDC USB um registro por quadro, em COBS entre bytes 0x00
+(layout em libs/Jogo_Bibliotecas/telemetria.c). Texto do printf no meio do
+fluxo é ignorado: só valem trechos com a soma de um registro. A sequência é
+uma só para todos os tipos, então ela é conferida em todo registro válido,
+inclusive os do espelho da tela, mas só os registros de quadro viram linhas
+do CSV. Saltos na sequência (registros descartados com o anel cheio) vão
+para stderr.
+
+Uso: telemetria_csv.py <fluxo.bin | /dev/ttyACM0> [saida.csv]
+     (na porta serial, configure antes com "stty -F /dev/ttyACM0 raw")
+"""
+import csv
+import struct
+import sys
+
+TIPO_QUADRO = 1
+CABECALHO = struct.Struct('<BI')   # tipo sequencia, comum a todos os tipos
+# tipo sequencia | tempo_ms passos renders matriz_enviadas matriz_puladas |
+# joystick_x joystick_y pontuacao renders_pulados prazos_perdidos jitter_medio_us jitter_max_us |
+# jogador_x jogador_y pixel_x pixel_y vidas estado | soma
+REGISTRO = struct.Struct('<BI5I7H6BB')
+CAMPOS = ('sequencia', 'tempo_ms', 'passos', 'renders', 'matriz_enviadas', 'matriz_puladas',
+          'joystick_x', 'joystick_y', 'pontuacao', 'renders_pulados', 'prazos_perdidos',
+          'jitter_medio_us', 'jitter_max_us', 'jogador_x', 'jogador_y', 'pixel_x', 'pixel_y',
+          'vidas', 'iniciado', 'pausado', 'fim', 'imune')
+ESTADOS = (0x01, 0x02, 0x04, 0x08)
+
+
+def cobs_decodificar(dados):
+    saida = bytearray()
+    i = 0
+    while i < len(dados):
+        codigo = dados[i]
+        if codigo == 0 or i + codigo > len(dados):
+            return None
+        saida += dados[i + 1:i + codigo]
+        i += codigo
+        if codigo < 0xFF and i < len(dados):
+            saida.append(0)
+    return bytes(saida)
+
+
+def registros(fluxo):
+    """Gera (sequencia, campos) dos registros válidos de qualquer tipo, na ordem do fluxo.
+
+    campos é None para os tipos que não são quadro."""
+    pendente = b''
+    while True:
+        bloco = fluxo.read(4096)
+        if not bloco:
+            break
+        trechos = (pendente + bloco).split(b'\0')
+        pendente = trechos.pop()
+        for trecho in trechos:
+            registro = cobs_decodificar(trecho) if trecho else None
+            if registro is None or len(registro) <= CABECALHO.size or sum(registro) & 0xFF:
+                continue
+            tipo, sequencia = CABECALHO.unpack_from(registro)
+            if tipo != TIPO_QUADRO:
+                yield sequencia, None
+                continue
+            if len(registro) != REGISTRO.size:
+                continue
+            valores = REGISTRO.unpack(registro)
+            estado = valores[-2]
+            yield sequencia, valores[1:-2] + tuple(int(bool(estado & bit)) for bit in ESTADOS)
+
+
+def main():
+    if len(sys.argv) not in (2, 3):
+        sys.exit(__doc__)
+    saida = open(sys.argv[2], 'w', newline='') if len(sys.argv) == 3 else sys.stdout
+    escritor = csv.writer(saida)
+    escritor.writerow(CAMPOS)
+    anterior, total, perdidos = None, 0, 0
+    with open(sys.argv[1], 'rb', buffering=0) as fluxo:
+        try:
+            for sequencia, valores in registros(fluxo):
+                if anterior is not None and sequencia != (anterior + 1) & 0xFFFFFFFF:
+                    salto = (sequencia - anterior - 1) & 0xFFFFFFFF
+                    perdidos += salto
+                    print('sequência %d -> %d: %d registro(s) perdido(s)' % (anterior, sequencia, salto),
+                          file=sys.stderr)
+                anterior = sequencia
+                if valores is None:
+                    continue
+                total += 1
+                escritor.writerow(valores)
+                saida.flush()
+        except KeyboardInterrupt:
+            pass
+    print('%d registros, %d perdidos' % (total, perdidos), file=sys.stderr)
+
+
+if __name__ == '__main__':
+    main()